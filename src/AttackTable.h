@@ -41,6 +41,24 @@ public:
 
     void initBetweenTable();
     uint64_t squaresBetween(int from, int to);
+
+    // Squares a slider on square attacks given the occupancy, through the magic tables
+    uint64_t rookAttacks(int square, uint64_t occupied) const
+    {
+        return rookTable[square][((occupied & rookMask[square]) * rookMagics[square]) >> (64 - rookIndex[square])];
+    }
+
+    uint64_t bishopAttacks(int square, uint64_t occupied) const
+    {
+        return bishopTable[square][((occupied & bishopMask[square]) * bishopMagics[square]) >> (64 - bishopIndex[square])];
+    }
+
+    static uint64_t kingAttacks(int square)
+    {
+        uint64_t king = 1ULL << square;
+        uint64_t sides = king | ((king & ~0x0101010101010101ULL) >> 1) | ((king & ~0x8080808080808080ULL) << 1);
+        return (sides | (sides >> 8) | (sides << 8)) & ~king;
+    }
     
     static constexpr std::array<std::pair<int, int>, 4> ROOK_DIRECTIONS = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
     static constexpr std::array<std::pair<int, int>, 4> BISHOP_DIRECTIONS = {{
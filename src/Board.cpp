@@ -1,4 +1,5 @@
 #include "Board.h"
+#include "PieceSquareTables.h"
 
 /*DEBUG FEN*/
 // 8/8/8/8/8/8/8/KR6 b - - 0 1
@@ -12,6 +13,7 @@
  * Initializes the board to the standard starting position and resets relevant game states.
  */
 Board::Board()
+    : transpositionTable(std::make_shared<TranspositionTable>())
 {
     setFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
     enPassantTarget = 0;
@@ -24,6 +26,7 @@ Board::Board()
     attackTable.initialize();
     initializeZobrist();
     zobristHash = computeZobristHash();
+    pawnKey = computePawnKey();
     allPieces = getBlackPieces() | getWhitePieces();
 }
 
@@ -31,11 +34,27 @@ Board::Board()
  * @brief Copy constructor for the Board class.
  *
  * Initializes a new board instance by copying all properties and states from the given Board object.
+ * The transposition table is shared rather than copied.
  */
 Board::Board(const std::shared_ptr<Board> &other1)
+    : transpositionTable(other1->transpositionTable)
+{
+    this->attackTable.initialize();
+    this->initializeZobrist();
+    copyPosition(*other1);
+}
+
+/**
+ * @brief Copies the position and game state of another board into this one.
+ *
+ * Only the state that changes from move to move is copied: bitboards, side to move, castling
+ * and en passant state, hash and the game history used for repetition detection. The attack
+ * and Zobrist tables are left alone, which keeps this cheap enough to run on every "go".
+ *
+ * @param other The board to copy the position from.
+ */
+void Board::copyPosition(const Board &other)
 {
-    const Board &other = *other1;
-    // Copy basic properties
     this->whitePawns = other.whitePawns;
     this->blackPawns = other.blackPawns;
     this->whiteKnights = other.whiteKnights;
@@ -58,11 +77,13 @@ Board::Board(const std::shared_ptr<Board> &other1)
     this->WhiteCanCastleK = other.WhiteCanCastleK;
     this->whiteToMove = other.whiteToMove;
     this->zobristHash = other.zobristHash;
+    this->evalTerms = other.evalTerms;
+    this->pawnKey = other.pawnKey;
     this->moveHistory = other.moveHistory;
+    this->moveCount = other.moveCount;
+    this->gameFensHistory = other.gameFensHistory;
     std::copy(std::begin(other.kingMovesTable), std::end(other.kingMovesTable), std::begin(this->kingMovesTable));
     std::copy(std::begin(other.pinMasks), std::end(other.pinMasks), std::begin(this->pinMasks));
-    this->attackTable.initialize();
-    this->initializeZobrist();
     allPieces = getBlackPieces() | getWhitePieces();
 }
 
@@ -314,31 +335,7 @@ uint64_t Board::computeZobristHash()
  */
 bool Board::probeTranspositionTable(uint64_t hash, int depth, int alpha, int beta, TTEntry &entry)
 {
-    TTEntry &result = transpositionTable[hash % TABLE_SIZE];
-
-    if (result.hash == hash) // Ensure we are checking the correct position
-    {
-        if (result.depth >= depth) // Only use if stored depth is sufficient
-        {
-            if (result.flag == TTFlag::EXACT)
-            {
-                entry = result;
-                return true;
-            }
-            else if (result.flag == TTFlag::LOWERBOUND && result.evaluation >= beta)
-            {
-                entry = result;
-                return true;
-            }
-            else if (result.flag == TTFlag::UPPERBOUND && result.evaluation <= alpha)
-            {
-                entry = result;
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return transpositionTable->probe(hash, depth, alpha, beta, entry);
 }
 
 /**
@@ -371,18 +368,7 @@ bool Board::probeTranspositionTable(uint64_t hash, int depth, int alpha, int bet
  */
 void Board::storeTransposition(uint64_t hash, int depth, int eval, int alpha, int beta, int from, int to)
 {
-    TTEntry &entry = transpositionTable[hash % TABLE_SIZE];
-    entry.hash = hash;
-    entry.evaluation = eval;
-    entry.depth = depth;
-    entry.bestFrom = from;
-    entry.bestTo = to;
-    if (eval <= alpha)
-        entry.flag = TTFlag::UPPERBOUND; // Eval is worse than or equal to beta, we can't improve
-    else if (eval >= beta)
-        entry.flag = TTFlag::LOWERBOUND; // Eval is better than or equal to alpha, we can't worsen
-    else
-        entry.flag = TTFlag::EXACT;
+    transpositionTable->store(hash, depth, eval, alpha, beta, from, to);
 }
 
 /**
@@ -525,8 +511,8 @@ bool Board::gameOver(bool maximizingPlayer)
  *
  * The process works as follows:
  * 1. The function determines the square of the king for the current player (either White or Black).
- * 2. It then calculates all the opponent's possible attacking squares using `getOpponentAttacks`.
- * 3. It checks if the king's square is included in the opponent's attacking squares.
+ * 2. It then looks for opponent pieces attacking that square using `findCheckers`, which only
+ *    tests the pieces that could reach the king instead of building the full attack map.
  *
  * @note This function assumes the board is correctly initialized and the player being checked is valid.
  */
@@ -535,8 +521,134 @@ bool Board::isKingInCheck(bool maximizingPlayer)
     int kingSquare = maximizingPlayer
                          ? bitScanForward(whiteKing.bitboard)
                          : bitScanForward(blackKing.bitboard);
-    uint64_t opponentAttacks = getOpponentAttacks(maximizingPlayer ? 'B' : 'w');
-    return (opponentAttacks & (1ULL << kingSquare)) != 0;
+    uint64_t checkMask = 0;
+    return findCheckers(kingSquare, maximizingPlayer ? 'K' : 'k', checkMask) != 0;
+}
+
+/**
+ * @brief Passes the turn without moving a piece (null move).
+ *
+ * Flips the side to move, clears the en passant square and updates the Zobrist key to match.
+ * The returned state must be handed to undoNullMove.
+ *
+ * @return The state needed to take the null move back.
+ */
+NullMoveState Board::makeNullMove()
+{
+    NullMoveState state{enPassantTarget, zobristHash};
+
+    zobristHash ^= sideToMoveHash;
+    if (enPassantTarget)
+    {
+        zobristHash ^= enPassantTable[bitScanForward(enPassantTarget) % 8];
+    }
+
+    enPassantTarget = 0;
+    whiteToMove = !whiteToMove;
+    return state;
+}
+
+void Board::undoNullMove(const NullMoveState &state)
+{
+    enPassantTarget = state.enPassantTarget;
+    zobristHash = state.hash;
+    whiteToMove = !whiteToMove;
+}
+
+/**
+ * @brief Returns true if the given side has a knight, bishop, rook or queen.
+ */
+bool Board::hasNonPawnMaterial(bool white)
+{
+    if (white)
+        return (whiteKnights.bitboard | whiteBishops.bitboard | whiteRooks.bitboard | whiteQueens.bitboard) != 0;
+    return (blackKnights.bitboard | blackBishops.bitboard | blackRooks.bitboard | blackQueens.bitboard) != 0;
+}
+
+/**
+ * @brief Adds a piece placed on a square to the incremental evaluation terms.
+ *
+ * Every change to the piece bitboards during make and unmake goes through this function or
+ * removePieceTerms(), so evalTerms and pawnKey always match the position.
+ */
+void Board::addPieceTerms(char piece, int square)
+{
+    int index = pieceToIndex(piece);
+    if (index < 0)
+        return;
+    if (piece == 'P' || piece == 'p')
+        pawnKey ^= zobristTable[index][square];
+    evalTerms.middlegame += PIECE_SQUARE_SCORES.middlegame[index][square];
+    evalTerms.endgame += PIECE_SQUARE_SCORES.endgame[index][square];
+    evalTerms.phase += PIECE_SQUARE_SCORES.phase[index];
+}
+
+void Board::removePieceTerms(char piece, int square)
+{
+    int index = pieceToIndex(piece);
+    if (index < 0)
+        return;
+    if (piece == 'P' || piece == 'p')
+        pawnKey ^= zobristTable[index][square];
+    evalTerms.middlegame -= PIECE_SQUARE_SCORES.middlegame[index][square];
+    evalTerms.endgame -= PIECE_SQUARE_SCORES.endgame[index][square];
+    evalTerms.phase -= PIECE_SQUARE_SCORES.phase[index];
+}
+
+/**
+ * @brief Computes the evaluation terms from scratch by walking every piece bitboard.
+ */
+EvalTerms Board::computeEvalTerms()
+{
+    const std::pair<char, const Bitboard *> pieces[] = {
+        {'P', &whitePawns}, {'p', &blackPawns}, {'N', &whiteKnights}, {'n', &blackKnights}, {'B', &whiteBishops}, {'b', &blackBishops}, {'R', &whiteRooks}, {'r', &blackRooks}, {'Q', &whiteQueens}, {'q', &blackQueens}, {'K', &whiteKing}, {'k', &blackKing}};
+
+    EvalTerms terms;
+    for (const auto &[piece, bitboard] : pieces)
+    {
+        int index = pieceToIndex(piece);
+        uint64_t remaining = bitboard->bitboard;
+        while (remaining)
+        {
+            int square = bitScanForward(remaining);
+            terms.middlegame += PIECE_SQUARE_SCORES.middlegame[index][square];
+            terms.endgame += PIECE_SQUARE_SCORES.endgame[index][square];
+            terms.phase += PIECE_SQUARE_SCORES.phase[index];
+            remaining &= remaining - 1;
+        }
+    }
+    return terms;
+}
+
+/**
+ * @brief Computes the pawn key from scratch: the Zobrist keys of every pawn XORed together.
+ */
+uint64_t Board::computePawnKey()
+{
+    uint64_t key = 0;
+    for (uint64_t pawns = whitePawns.bitboard; pawns; pawns &= pawns - 1)
+        key ^= zobristTable[pieceToIndex('P')][bitScanForward(pawns)];
+    for (uint64_t pawns = blackPawns.bitboard; pawns; pawns &= pawns - 1)
+        key ^= zobristTable[pieceToIndex('p')][bitScanForward(pawns)];
+    return key;
+}
+
+/**
+ * @brief Debug check of the incremental evaluation terms and pawn key against a full recompute.
+ *
+ * @return true if they match; otherwise both are reported on std::cerr.
+ */
+bool Board::verifyEvalTerms()
+{
+    EvalTerms expected = computeEvalTerms();
+    uint64_t expectedPawnKey = computePawnKey();
+    if (evalTerms == expected && pawnKey == expectedPawnKey)
+        return true;
+
+    std::cerr << "Error: incremental eval terms " << evalTerms.middlegame << "/" << evalTerms.endgame << "/" << evalTerms.phase
+              << " pawn key " << pawnKey << " differ from recomputed " << expected.middlegame << "/" << expected.endgame
+              << "/" << expected.phase << " pawn key " << expectedPawnKey << " in " << getFen() << std::endl;
+    return false;
 }
 
 /**
@@ -566,6 +678,7 @@ bool Board::isKingInCheck(bool maximizingPlayer)
  * - Sets the castling rights for both players (White and Black).
  * - Sets the en passant target square.
  * - Initializes the halfmove clock and fullmove number.
+ * - Recomputes the Zobrist hash, the pawn key and the incremental evaluation terms.
  *
  * @note The FEN format must be valid for the function to correctly set up the board state. If any part of the
  *       FEN string is malformed or missing, the behavior IS UNDEFINED.
@@ -647,6 +760,11 @@ void Board::setFen(const std::string &fen)
         whiteToMove = true;
     else
         whiteToMove = false;
+
+    allPieces = getBlackPieces() | getWhitePieces();
+    evalTerms = computeEvalTerms();
+    pawnKey = computePawnKey();
+    zobristHash = computeZobristHash();
 }
 
 /**
@@ -827,12 +945,15 @@ void Board::undoMove(LastMove lastmove)
         {
             whiteQueens.clearSquare(lastmove.to);
             whitePawns.setSquare(lastmove.from);
+            removePieceTerms('Q', lastmove.to);
         }
         else
         {
             blackQueens.clearSquare(lastmove.to);
             blackPawns.setSquare(lastmove.from);
+            removePieceTerms('q', lastmove.to);
         }
+        addPieceTerms(lastmove.originalPawn, lastmove.from);
     }
     else
     {
@@ -893,6 +1014,8 @@ void Board::restoreCapturedPiece(int square, char piece)
         blackKing.setSquare(square);
     if (piece == 'K')
         whiteKing.setSquare(square);
+
+    addPieceTerms(piece, square);
 }
 
 /**
@@ -1044,12 +1167,15 @@ bool Board::movePiece(int from, int to)
         {
             whitePawns.clearSquare(to);
             whiteQueens.setSquare(to);
+            addPieceTerms('Q', to);
         }
         else
         {
             blackPawns.clearSquare(to);
             blackQueens.setSquare(to);
+            addPieceTerms('q', to);
         }
+        removePieceTerms(piece, to);
     }
     storeMove(from, to, destPiece, enPassantTarget, lastMoveEnPassant,
               enpassantCapturedSquare,
@@ -1143,6 +1269,8 @@ void Board::clearCapturedPiece(int to, char destPiece)
             blackKing.clearSquare(to);
         if (destPiece == 'K')
             whiteKing.clearSquare(to);
+
+        removePieceTerms(destPiece, to);
     }
 }
 
@@ -2145,6 +2273,302 @@ Move Board::getAllLegalMovesAsArray(Move movesList[], bool maximizingPlayer)
     return {captureCount + moveCount + attackedCount, captureCount};
 }
 
+/**
+ * @brief Generates the legal captures and promotions for the side to move.
+ *
+ * Used by the quiescence search, which only looks at moves that change the material balance.
+ * It reuses the per-piece generators (so pins and checks are respected) but skips the
+ * opponent attack map that the full generator builds for move ordering. King moves are
+ * only generated when an enemy piece stands next to the king, since that generator is the
+ * most expensive one.
+ *
+ * @param movesList Pre-allocated array receiving the moves.
+ * @param maximizingPlayer True for white, false for black.
+ * @return The number of moves written to movesList.
+ */
+int Board::getCaptureMovesAsArray(Move movesList[], bool maximizingPlayer)
+{
+    constexpr uint64_t FILE_A = 0x0101010101010101ULL;
+    constexpr uint64_t FILE_H = 0x8080808080808080ULL;
+    constexpr uint64_t RANK_8 = 0x00000000000000FFULL;
+    constexpr uint64_t RANK_1 = 0xFF00000000000000ULL;
+
+    int count = 0;
+
+    uint64_t ownPieces = maximizingPlayer ? getWhitePieces() : getBlackPieces();
+    uint64_t enemyPieces = maximizingPlayer ? getBlackPieces() : getWhitePieces();
+    uint64_t promotionRank = maximizingPlayer ? RANK_8 : RANK_1;
+
+    while (ownPieces)
+    {
+        int fromSquare = bitScanForward(ownPieces);
+        char piece = getPieceAtSquare(fromSquare);
+        uint64_t moves = 0;
+
+        switch (std::tolower(piece))
+        {
+        case 'p':
+            moves = generatePawnMoves(fromSquare, piece) & (enemyPieces | enPassantTarget | promotionRank);
+            break;
+        case 'n':
+            moves = generateKnightMoves(fromSquare, piece) & enemyPieces;
+            break;
+        case 'b':
+            moves = generateBishopMoves(fromSquare, piece) & enemyPieces;
+            break;
+        case 'r':
+            moves = generateRookMoves(fromSquare, piece) & enemyPieces;
+            break;
+        case 'q':
+            moves = generateQueenMoves(fromSquare, piece) & enemyPieces;
+            break;
+        case 'k':
+        {
+            uint64_t king = 1ULL << fromSquare;
+            uint64_t sides = king | ((king & ~FILE_A) >> 1) | ((king & ~FILE_H) << 1);
+            uint64_t neighbours = sides | (sides >> 8) | (sides << 8);
+            if (neighbours & enemyPieces)
+                moves = generateKingMoves(fromSquare, piece) & enemyPieces;
+            break;
+        }
+        }
+
+        while (moves)
+        {
+            movesList[count++] = {fromSquare, bitScanForward(moves)};
+            moves &= moves - 1;
+        }
+
+        ownPieces &= ownPieces - 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns every piece of either colour that attacks square, given the occupancy.
+ *
+ * Sliders are looked up with the occupancy passed in rather than the board's, so removing
+ * a piece from occupied reveals the x-ray attackers standing behind it.
+ */
+uint64_t Board::attackersTo(int square, uint64_t occupied)
+{
+    uint64_t bit = 1ULL << square;
+    int file = square % 8;
+
+    // White pawns attack towards square 0, black pawns towards square 63
+    uint64_t whitePawnSources = 0;
+    uint64_t blackPawnSources = 0;
+    if (square < 56)
+    {
+        if (file != 0)
+            whitePawnSources |= bit << 7;
+        if (file != 7)
+            whitePawnSources |= bit << 9;
+    }
+    if (square >= 8)
+    {
+        if (file != 0)
+            blackPawnSources |= bit >> 9;
+        if (file != 7)
+            blackPawnSources |= bit >> 7;
+    }
+
+    uint64_t diagonal = whiteBishops.bitboard | blackBishops.bitboard | whiteQueens.bitboard | blackQueens.bitboard;
+    uint64_t straight = whiteRooks.bitboard | blackRooks.bitboard | whiteQueens.bitboard | blackQueens.bitboard;
+
+    return (whitePawnSources & whitePawns.bitboard) |
+           (blackPawnSources & blackPawns.bitboard) |
+           (attackTable.knightMovesTable[square] & (whiteKnights.bitboard | blackKnights.bitboard)) |
+           (AttackTable::kingAttacks(square) & (whiteKing.bitboard | blackKing.bitboard)) |
+           (attackTable.bishopAttacks(square, occupied) & diagonal) |
+           (attackTable.rookAttacks(square, occupied) & straight);
+}
+
+/**
+ * @brief Whether move, not yet played, checks the opponent's king, directly or by uncovering
+ *        a slider behind the moving piece. A promotion is taken to be to a queen, as movePiece does.
+ */
+bool Board::givesCheck(Move move)
+{
+    char piece = getPieceAtSquare(move.from);
+    bool white = std::isupper(piece);
+    uint64_t enemyKing = white ? blackKing.bitboard : whiteKing.bitboard;
+    if (!enemyKing)
+        return false;
+
+    int kingSquare = bitScanForward(enemyKing);
+    char type = std::tolower(piece);
+    int fromFile = move.from % 8;
+    int toFile = move.to % 8;
+    uint64_t fromBit = 1ULL << move.from;
+    uint64_t toBit = 1ULL << move.to;
+    uint64_t occupied = (allPieces & ~fromBit) | toBit;
+
+    // Castling can only check with the rook, which lands next to the king's starting square
+    if (type == 'k' && std::abs(toFile - fromFile) == 2)
+    {
+        int rookFrom = toFile == 6 ? move.from + 3 : move.from - 4;
+        uint64_t rookTo = 1ULL << ((move.from + move.to) / 2);
+        occupied = (occupied & ~(1ULL << rookFrom)) | rookTo;
+        return attackTable.rookAttacks(kingSquare, occupied) & rookTo;
+    }
+
+    // En passant also empties the captured pawn's square, which can uncover a slider
+    if (type == 'p' && fromFile != toFile && getPieceAtSquare(move.to) == ' ')
+        occupied &= ~(1ULL << ((move.from / 8) * 8 + toFile));
+    if (type == 'p' && (move.to < 8 || move.to >= 56))
+        type = 'q';
+
+    uint64_t diagonalFromKing = attackTable.bishopAttacks(kingSquare, occupied);
+    uint64_t straightFromKing = attackTable.rookAttacks(kingSquare, occupied);
+
+    // Direct check by the piece on its new square
+    switch (type)
+    {
+    case 'p':
+        // White pawns attack towards square 0, black pawns towards square 63
+        if (white && ((toFile != 0 && kingSquare == move.to - 9) || (toFile != 7 && kingSquare == move.to - 7)))
+            return true;
+        if (!white && ((toFile != 0 && kingSquare == move.to + 7) || (toFile != 7 && kingSquare == move.to + 9)))
+            return true;
+        break;
+    case 'n':
+        if (attackTable.knightMovesTable[kingSquare] & toBit)
+            return true;
+        break;
+    case 'b':
+        if (diagonalFromKing & toBit)
+            return true;
+        break;
+    case 'r':
+        if (straightFromKing & toBit)
+            return true;
+        break;
+    case 'q':
+        if ((diagonalFromKing | straightFromKing) & toBit)
+            return true;
+        break;
+    }
+
+    // Discovered check by a slider that stood behind the moving or the captured piece
+    uint64_t ownDiagonal = white ? whiteBishops.bitboard | whiteQueens.bitboard : blackBishops.bitboard | blackQueens.bitboard;
+    uint64_t ownStraight = white ? whiteRooks.bitboard | whiteQueens.bitboard : blackRooks.bitboard | blackQueens.bitboard;
+    return ((diagonalFromKing & ownDiagonal) | (straightFromKing & ownStraight)) & ~fromBit;
+}
+
+/**
+ * @brief Static exchange evaluation: material won or lost by move when both sides keep
+ *        recapturing on the target square with their least valuable attacker.
+ *
+ * Each side may stop capturing whenever continuing would lose material. Pins are ignored.
+ * Works for quiet moves too, where it tells whether the moved piece can be won.
+ *
+ * @return The expected material balance for the side making the move, in centipawns.
+ */
+int Board::staticExchange(Move move)
+{
+    constexpr int KING_VALUE = 20000;
+
+    int gain[32];
+    int depth = 0;
+
+    char mover = getPieceAtSquare(move.from);
+    char victim = getPieceAtSquare(move.to);
+    bool white = std::isupper(mover);
+    bool pawn = std::tolower(mover) == 'p';
+
+    uint64_t occupied = getOccupiedSquares() ^ (1ULL << move.from);
+
+    gain[0] = pieceValue(victim);
+    int attackerValue = pawn ? 100 : std::tolower(mover) == 'k' ? KING_VALUE : pieceValue(mover);
+
+    if (pawn && victim == ' ' && (move.from % 8) != (move.to % 8))
+    {
+        // En passant: the captured pawn is not on the target square
+        gain[0] = 100;
+        occupied ^= 1ULL << (move.to + (white ? 8 : -8));
+    }
+    if (pawn && (move.to < 8 || move.to >= 56))
+    {
+        gain[0] += 800;
+        attackerValue = 900;
+    }
+
+    uint64_t attackers = attackersTo(move.to, occupied) & occupied;
+
+    const Bitboard *ordered[2][6] = {
+        {&blackPawns, &blackKnights, &blackBishops, &blackRooks, &blackQueens, &blackKing},
+        {&whitePawns, &whiteKnights, &whiteBishops, &whiteRooks, &whiteQueens, &whiteKing}};
+    const int values[6] = {100, 300, 320, 500, 900, KING_VALUE};
+
+    uint64_t diagonal = whiteBishops.bitboard | blackBishops.bitboard | whiteQueens.bitboard | blackQueens.bitboard;
+    uint64_t straight = whiteRooks.bitboard | blackRooks.bitboard | whiteQueens.bitboard | blackQueens.bitboard;
+
+    bool side = !white;
+    while (depth < 31)
+    {
+        // Least valuable attacker of the side to recapture
+        int type = -1;
+        uint64_t from = 0;
+        for (int t = 0; t < 6 && type < 0; ++t)
+        {
+            uint64_t candidates = attackers & ordered[side][t]->bitboard;
+            if (candidates)
+            {
+                type = t;
+                from = candidates & (~candidates + 1);
+            }
+        }
+        if (type < 0)
+            break;
+
+        depth++;
+        gain[depth] = attackerValue - gain[depth - 1];
+        if (std::max(-gain[depth - 1], gain[depth]) < 0)
+            break; // Neither side can gain by continuing
+
+        occupied ^= from;
+        if (type == 0 || type == 2 || type == 4)
+            attackers |= attackTable.bishopAttacks(move.to, occupied) & diagonal;
+        if (type == 3 || type == 4)
+            attackers |= attackTable.rookAttacks(move.to, occupied) & straight;
+        attackers &= occupied;
+
+        attackerValue = values[type];
+        side = !side;
+    }
+
+    while (depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
+}
+
+/**
+ * @brief Returns the material value of a piece in centipawns, 0 for kings and empty squares.
+ */
+int Board::pieceValue(char piece)
+{
+    switch (std::tolower(piece))
+    {
+    case 'p':
+        return 100;
+    case 'n':
+        return 300;
+    case 'b':
+        return 320;
+    case 'r':
+        return 500;
+    case 'q':
+        return 900;
+    default:
+        return 0;
+    }
+}
+
 /**
  * @brief Converts a move from square to square into its algebraic notation.
  *
@@ -2515,7 +2939,7 @@ uint64_t Board::getEmptySquares()
  * 'from' square to the 'to' square. It clears the bit in the bitboard of the piece
  * from the 'from' square and sets the bit in the bitboard of the piece at the 'to' square.
  * The function handles updates for both white and black pieces, including pawns, knights,
- * bishops, rooks, queens, and kings.
+ * bishops, rooks, queens, and kings. The incremental evaluation terms move with the piece.
  *
  * @param piece The piece being moved ('P' for white pawn, 'p' for black pawn, 'N' for white knight,
  *              'n' for black knight, 'B' for white bishop, 'b' for black bishop, 'R' for white rook,
@@ -2528,80 +2952,34 @@ uint64_t Board::getEmptySquares()
  */
 bool Board::updateBitboards(char piece, int from, int to)
 {
-    if (piece == 'P' && whitePawns.isSet(from))
-    {
-        whitePawns.clearSquare(from);
-        whitePawns.setSquare(to);
-        return true;
-    }
-    else if (piece == 'p' && blackPawns.isSet(from))
-    {
-        blackPawns.clearSquare(from);
-        blackPawns.setSquare(to);
-        return true;
-    }
-    else if (piece == 'N' && whiteKnights.isSet(from))
-    {
-        whiteKnights.clearSquare(from);
-        whiteKnights.setSquare(to);
-        return true;
-    }
-    else if (piece == 'n' && blackKnights.isSet(from))
-    {
-        blackKnights.clearSquare(from);
-        blackKnights.setSquare(to);
-        return true;
-    }
-    else if (piece == 'B' && whiteBishops.isSet(from))
-    {
-        whiteBishops.clearSquare(from);
-        whiteBishops.setSquare(to);
-        return true;
-    }
-    else if (piece == 'b' && blackBishops.isSet(from))
-    {
-        blackBishops.clearSquare(from);
-        blackBishops.setSquare(to);
-        return true;
-    }
-    else if (piece == 'R' && whiteRooks.isSet(from))
-    {
-        whiteRooks.clearSquare(from);
-        whiteRooks.setSquare(to);
-        return true;
-    }
-    else if (piece == 'r' && blackRooks.isSet(from))
-    {
-        blackRooks.clearSquare(from);
-        blackRooks.setSquare(to);
-        return true;
-    }
-    else if (piece == 'Q' && whiteQueens.isSet(from))
-    {
-        whiteQueens.clearSquare(from);
-        whiteQueens.setSquare(to);
-        return true;
-    }
-    else if (piece == 'q' && blackQueens.isSet(from))
-    {
-        blackQueens.clearSquare(from);
-        blackQueens.setSquare(to);
-        return true;
-    }
-    else if (piece == 'K' && whiteKing.isSet(from))
+    Bitboard *pieces = nullptr;
+    switch (piece)
     {
-        whiteKing.clearSquare(from);
-        whiteKing.setSquare(to);
-        return true;
+    case 'P': pieces = &whitePawns; break;
+    case 'p': pieces = &blackPawns; break;
+    case 'N': pieces = &whiteKnights; break;
+    case 'n': pieces = &blackKnights; break;
+    case 'B': pieces = &whiteBishops; break;
+    case 'b': pieces = &blackBishops; break;
+    case 'R': pieces = &whiteRooks; break;
+    case 'r': pieces = &blackRooks; break;
+    case 'Q': pieces = &whiteQueens; break;
+    case 'q': pieces = &blackQueens; break;
+    case 'K': pieces = &whiteKing; break;
+    case 'k': pieces = &blackKing; break;
+    default: return false;
     }
-    else if (piece == 'k' && blackKing.isSet(from))
+
+    if (!pieces->isSet(from))
     {
-        blackKing.clearSquare(from);
-        blackKing.setSquare(to);
-        return true;
+        return false;
     }
 
-    return false;
+    pieces->clearSquare(from);
+    pieces->setSquare(to);
+    removePieceTerms(piece, from);
+    addPieceTerms(piece, to);
+    return true;
 }
 
 /**
@@ -5,6 +5,7 @@
 #include <cctype>
 #include <cstdlib>
 #include "AttackTable.h"
+#include "TranspositionTable.h"
 #include <unordered_map>
 #include <random>
 #include <cstdint>
@@ -12,31 +13,10 @@
 #include <bitset>
 #include <array>
 #include <sstream>
-
-constexpr int TABLE_SIZE = 20971521;
+#include <memory>
 
 constexpr size_t MAX_MOVES = 512;
 
-
-enum TTFlag
-{
-    EXACT,
-    LOWERBOUND,
-    UPPERBOUND
-};
-struct TTEntry
-{
-    int evaluation;
-    int depth;
-    int bestFrom;
-    int bestTo;
-    TTFlag flag;
-    uint64_t hash;
-
-    TTEntry(int eval = 0, int d = 0, TTFlag f = EXACT, int bf = -1, int bt = -1)
-        : evaluation(eval), depth(d), flag(f), bestFrom(bf), bestTo(bt), hash(0) {}
-};
-
 struct LastMove
 {
     int from, to;
@@ -53,6 +33,26 @@ struct LastMove
     bool whiteTurn;
 };
 
+// Everything a null move changes besides the side to move
+struct NullMoveState
+{
+    uint64_t enPassantTarget;
+    uint64_t hash;
+};
+
+/**
+ * @brief Evaluation terms the board keeps up to date as pieces move: material plus
+ * piece-square score for the middlegame and the endgame from white's point of view, and the
+ * game phase (see PieceSquareTables.h).
+ */
+struct EvalTerms
+{
+    int middlegame = 0;
+    int endgame = 0;
+    int phase = 0;
+
+    bool operator==(const EvalTerms &other) const = default;
+};
 
 struct Move{ 
     int from, to; 
@@ -72,6 +72,7 @@ public:
     Board();
     Board(const std::shared_ptr<Board> &other);
 
+    void copyPosition(const Board &other);
     void setFen(const std::string &fen);
     std::string getFen();
     void resetBoard();
@@ -80,6 +81,8 @@ public:
     //Move handling
     bool movePiece(int from, int to);
     void undoMove(LastMove lastmove);
+    NullMoveState makeNullMove();
+    void undoNullMove(const NullMoveState &state);
     void restoreCapturedPiece(int square, char piece);
     bool updateBitboards(char piece, int from, int to);
     bool isValidMove(int from, int to);
@@ -113,6 +116,7 @@ public:
 
     uint16_t *getAllLegalMoves(bool maximizingPlayer);
     Move getAllLegalMovesAsArray(Move movesList[], bool maximizingPlayer);
+    int getCaptureMovesAsArray(Move movesList[], bool maximizingPlayer);
 
     //Move gen helpers
     uint64_t findCheckers(int squareOfKing, char king, uint64_t &checkMask);
@@ -121,6 +125,9 @@ public:
     bool isPiecePinnedToKing(int pieceSquare, int squareOfKing, uint64_t lineOfSight);
     bool isPiecePinned(int pieceSquare, int squareOfKing, char king);
     int countAttackedSquares(int square, char piece);
+    uint64_t attackersTo(int square, uint64_t occupied);
+    bool givesCheck(Move move);
+    int staticExchange(Move move);
 
     //Helpers
     bool gameOver(bool maximizingPlayer);
@@ -158,6 +165,14 @@ public:
     bool isThreefoldRepetition();
     bool isDraw(bool maximizingPlayer);
     bool isKingInCheck(bool maximizingPlayer);
+    bool hasNonPawnMaterial(bool white);
+
+    //Incremental evaluation
+    void addPieceTerms(char piece, int square);
+    void removePieceTerms(char piece, int square);
+    EvalTerms computeEvalTerms();
+    uint64_t computePawnKey();
+    bool verifyEvalTerms();
     void precomputeKingMoves();
     
 
@@ -220,6 +235,9 @@ public:
 
     //Zobrist hashing variables
     uint64_t zobristHash;
+
+    // Zobrist key of the pawns alone, updated incrementally with evalTerms; indexes the pawn table
+    uint64_t pawnKey = 0;
     static constexpr int PIECES = 12;
     static constexpr int SQUARES = 64;
     static constexpr int CASTLING_RIGHTS = 4;
@@ -231,7 +249,8 @@ public:
     uint64_t enPassantTable[EN_PASSANT_FILES];
     uint64_t sideToMoveHash;
 
-    TTEntry transpositionTable[TABLE_SIZE]; 
+    // Shared with every board copied from this one so helper searches reuse each other's results
+    std::shared_ptr<TranspositionTable> transpositionTable;
 
     bool whiteToMove;
 
@@ -239,6 +258,9 @@ public:
 
     uint64_t allPieces;
     char pieceAt[64];
+
+    // Updated by every make and unmake; equal to computeEvalTerms() between moves
+    EvalTerms evalTerms;
 };
 
 #endif // BOARD_H
\ No newline at end of file
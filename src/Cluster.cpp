@@ -0,0 +1,427 @@
+#include "Cluster.h"
+#include "Node.h"
+#include "Evaluation.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define BOTFISH_HAS_CLUSTER 1
+#endif
+
+#ifdef BOTFISH_HAS_CLUSTER
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+/**
+ * Writes one newline terminated message. Returns false if the peer is gone.
+ */
+static bool sendLine(int fd, const std::string &line)
+{
+    std::string data = line + "\n";
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, SEND_FLAGS);
+        if (n <= 0)
+            return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * Reads from fd until buffer holds a complete line or timeoutMs elapses (-1 blocks).
+ * Returns 1 with the line, 0 on timeout and -1 when the peer closed the connection.
+ */
+static int readLine(int fd, std::string &buffer, std::string &line, int timeoutMs)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (true)
+    {
+        size_t newline = buffer.find('\n');
+        if (newline != std::string::npos)
+        {
+            line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            return 1;
+        }
+
+        int wait = -1;
+        if (timeoutMs >= 0)
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0)
+                return 0;
+            wait = static_cast<int>(left);
+        }
+
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, wait);
+        if (ready == 0)
+            return 0;
+        if (ready < 0)
+            return -1;
+
+        char chunk[512];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            return -1;
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+static bool makeAddress(const std::string &path, sockaddr_un &address)
+{
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Error: cluster socket path too long: " << path << std::endl;
+        return false;
+    }
+    address = {};
+    address.sun_family = AF_UNIX;
+    std::copy(path.begin(), path.end(), address.sun_path);
+    return true;
+}
+
+ClusterLeader::~ClusterLeader()
+{
+    shutdown();
+}
+
+/**
+ * Moves the table into shared memory and opens the listening socket. Workers may
+ * connect at any time; they are picked up on the next search.
+ */
+bool ClusterLeader::start(const std::string &path, const std::shared_ptr<TranspositionTable> &table)
+{
+    shutdown();
+
+    sockaddr_un address;
+    if (!makeAddress(path, address))
+        return false;
+
+    std::string name = "/botfish-tt-" + std::to_string(getpid());
+    if (!table->attachShared(name, true))
+        return false;
+
+    unlink(path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(fd, 16) != 0)
+    {
+        std::cerr << "Error: could not listen on cluster socket " << path << std::endl;
+        if (fd >= 0)
+            close(fd);
+        table->detachShared();
+        return false;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    listenFd = fd;
+    socketPath = path;
+    shmName = name;
+    return true;
+}
+
+void ClusterLeader::shutdown()
+{
+    for (Peer &peer : workers)
+    {
+        sendLine(peer.fd, "quit");
+        close(peer.fd);
+    }
+    workers.clear();
+
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        unlink(socketPath.c_str());
+        listenFd = -1;
+    }
+}
+
+void ClusterLeader::acceptPending()
+{
+    if (listenFd < 0)
+        return;
+
+    int fd;
+    while ((fd = accept(listenFd, nullptr, nullptr)) >= 0)
+    {
+        if (sendLine(fd, "hash " + shmName))
+            workers.push_back({fd, ""});
+        else
+            close(fd);
+    }
+}
+
+void ClusterLeader::dropPeer(size_t index)
+{
+    close(workers[index].fd);
+    workers.erase(workers.begin() + index);
+}
+
+int ClusterLeader::workerCount()
+{
+    acceptPending();
+    return static_cast<int>(workers.size());
+}
+
+void ClusterLeader::broadcastSearch(const std::string &fen, const std::unordered_map<uint64_t, int> &history, int depth)
+{
+    acceptPending();
+    searchId++;
+
+    // A FEN carries no game history; without it the workers could not see repetitions
+    std::string historyLine = "history";
+    for (const auto &[hash, count] : history)
+    {
+        historyLine += " " + std::to_string(hash) + " " + std::to_string(count);
+    }
+
+    for (size_t i = 0; i < workers.size();)
+    {
+        int workerDepth = depth + static_cast<int>(i % 2);
+        if (sendLine(workers[i].fd, historyLine) &&
+            sendLine(workers[i].fd, "search " + std::to_string(searchId) + " " + std::to_string(workerDepth) + " " + fen))
+            i++;
+        else
+            dropPeer(i);
+    }
+}
+
+/**
+ * Stops the current search on every worker and waits up to timeoutMs for their reports.
+ * The result with the deepest completed iteration wins; the leader's own result wins ties
+ * since it searched the exact requested depth. Node counts of all processes are summed.
+ */
+SearchResult ClusterLeader::collectResults(const SearchResult &own, int timeoutMs)
+{
+    SearchResult best = own;
+    uint64_t totalNodes = own.nodes;
+
+    for (size_t i = 0; i < workers.size();)
+    {
+        sendLine(workers[i].fd, "stop " + std::to_string(searchId));
+        i++;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (size_t i = 0; i < workers.size();)
+    {
+        bool answered = false;
+        bool lost = false;
+
+        while (!answered)
+        {
+            int left = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+            std::string line;
+            int status = readLine(workers[i].fd, workers[i].buffer, line, std::max(left, 0));
+            if (status < 0)
+            {
+                lost = true;
+                break;
+            }
+            if (status == 0)
+                break;
+
+            std::istringstream iss(line);
+            std::string tag;
+            int id;
+            SearchResult result;
+            if (!(iss >> tag >> id >> result.depth >> result.score >> result.move.from >> result.move.to >> result.nodes) || tag != "result")
+                continue;
+            if (id != searchId)
+                continue; // Late answer to an earlier search
+
+            answered = true;
+            totalNodes += result.nodes;
+            if (result.depth > best.depth && result.move.from >= 0)
+            {
+                best = result;
+            }
+        }
+
+        if (lost)
+            dropPeer(i);
+        else
+            i++;
+    }
+
+    best.nodes = totalNodes;
+    best.quiescenceNodes = own.quiescenceNodes;
+    best.branchingFactor = own.branchingFactor;
+    best.betaCutoffs = own.betaCutoffs;
+    best.firstMoveCutoffs = own.firstMoveCutoffs;
+    best.pawnTableProbes = own.pawnTableProbes;
+    best.pawnTableHits = own.pawnTableHits;
+    return best;
+}
+
+/**
+ * Worker process main loop. A reader thread turns "stop" messages into the search's
+ * abort flag while the main thread searches; everything else is queued in order.
+ */
+int runClusterWorker(const std::string &path)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address))
+        return 1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        std::cerr << "Error: could not connect to cluster leader at " << path << std::endl;
+        if (fd >= 0)
+            close(fd);
+        return 1;
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::string> queue;
+    std::atomic<bool> stop{false};
+    int stoppedId = 0;
+
+    std::thread reader([&]()
+                       {
+        std::string buffer, line;
+        while (readLine(fd, buffer, line, -1) > 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (line.rfind("stop", 0) == 0)
+            {
+                stoppedId = std::atoi(line.c_str() + 4);
+                stop = true;
+                continue;
+            }
+            queue.push_back(line);
+            ready.notify_one();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        queue.push_back("quit");
+        ready.notify_one(); });
+
+    auto board = std::make_shared<Board>();
+    Evaluation evaluate(board);
+    Node root;
+    root.stopFlag = &stop;
+    std::unordered_map<uint64_t, int> history;
+
+    while (true)
+    {
+        std::string line;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&]()
+                       { return !queue.empty(); });
+            line = queue.front();
+            queue.pop_front();
+        }
+
+        std::istringstream iss(line);
+        std::string cmd;
+        iss >> cmd;
+
+        if (cmd == "hash")
+        {
+            std::string name;
+            iss >> name;
+            board->transpositionTable->attachShared(name, false);
+        }
+        else if (cmd == "history")
+        {
+            history.clear();
+            uint64_t hash;
+            int count;
+            while (iss >> hash >> count)
+            {
+                history[hash] = count;
+            }
+        }
+        else if (cmd == "search")
+        {
+            int id, depth;
+            std::string fen;
+            iss >> id >> depth;
+            std::getline(iss, fen);
+
+            bool skip;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                skip = stoppedId >= id;
+                if (!skip)
+                    stop = false;
+            }
+
+            SearchResult result;
+            if (!skip)
+            {
+                board->setFen(fen.substr(fen.find_first_not_of(' ')));
+                board->gameFensHistory = history;
+                auto [score, move] = root.iterativeDeepening(board, depth, board->whiteToMove, evaluate);
+                result = {root.completedDepth, score, move, root.nodesExplored};
+            }
+
+            sendLine(fd, "result " + std::to_string(id) + " " + std::to_string(result.depth) + " " +
+                             std::to_string(result.score) + " " + std::to_string(result.move.from) + " " +
+                             std::to_string(result.move.to) + " " + std::to_string(result.nodes));
+        }
+        else if (cmd == "quit")
+        {
+            break;
+        }
+    }
+
+    ::shutdown(fd, SHUT_RDWR);
+    reader.join();
+    close(fd);
+    return 0;
+}
+
+#else
+
+ClusterLeader::~ClusterLeader() {}
+
+bool ClusterLeader::start(const std::string &, const std::shared_ptr<TranspositionTable> &)
+{
+    std::cerr << "Error: cluster mode needs POSIX shared memory and Unix sockets" << std::endl;
+    return false;
+}
+
+void ClusterLeader::shutdown() {}
+int ClusterLeader::workerCount() { return 0; }
+void ClusterLeader::broadcastSearch(const std::string &, const std::unordered_map<uint64_t, int> &, int) {}
+void ClusterLeader::acceptPending() {}
+void ClusterLeader::dropPeer(size_t) {}
+
+SearchResult ClusterLeader::collectResults(const SearchResult &own, int)
+{
+    return own;
+}
+
+int runClusterWorker(const std::string &)
+{
+    std::cerr << "Error: cluster mode needs POSIX shared memory and Unix sockets" << std::endl;
+    return 1;
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef CLUSTER_H
+#define CLUSTER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Board.h"
+#include "TranspositionTable.h"
+#include "Node.h"
+
+/**
+ * Multi-process search over one shared transposition table.
+ *
+ * The leader is the process talking UCI. It moves its table into POSIX shared memory and
+ * listens on a Unix socket. Workers are started separately with
+ * `chessEngine --cluster-worker <socket>`, attach to the same table and search every root
+ * position the leader broadcasts. When the leader's own search is done it stops the workers
+ * and keeps the deepest completed result.
+ *
+ * Protocol (one text line per message):
+ *   leader -> worker: "hash <shm name>", "history [<hash> <count>]...", "search <id> <depth> <fen>",
+ *                     "stop <id>", "quit"
+ *   worker -> leader: "result <id> <completed depth> <score> <from> <to> <nodes>"
+ */
+class ClusterLeader
+{
+public:
+    ~ClusterLeader();
+
+    // Creates the shared table and starts listening on socketPath
+    bool start(const std::string &socketPath, const std::shared_ptr<TranspositionTable> &table);
+
+    // Tells every worker to quit and releases the socket
+    void shutdown();
+
+    bool isRunning() const { return listenFd >= 0; }
+
+    // Accepts newly connected workers and returns how many are attached
+    int workerCount();
+
+    // Sends the root position and its repetition history to every worker; odd workers search
+    // one ply deeper
+    void broadcastSearch(const std::string &fen, const std::unordered_map<uint64_t, int> &history, int depth);
+
+    // Stops the workers and returns the deepest result, preferring own on ties
+    SearchResult collectResults(const SearchResult &own, int timeoutMs);
+
+private:
+    struct Peer
+    {
+        int fd;
+        std::string buffer;
+    };
+
+    void acceptPending();
+    void dropPeer(size_t index);
+
+    int listenFd = -1;
+    std::string socketPath;
+    std::string shmName;
+    std::vector<Peer> workers;
+    int searchId = 0;
+};
+
+// Entry point for a worker process; returns the process exit code
+int runClusterWorker(const std::string &socketPath);
+
+#endif // CLUSTER_H
@@ -1,161 +1,214 @@
 #include "Evaluation.h"
 #include "Board.h"
 
+// Pawn structure terms, in centipawns per pawn
+constexpr int PASSED_PAWN_BONUS = 50;
+constexpr int ISOLATED_PAWN_PENALTY = 15;
+constexpr int DOUBLED_PAWN_PENALTY = 15;
+constexpr int BACKWARD_PAWN_PENALTY = 10;
+
+// Rook bonus on a file without any pawn, and on one without own pawns only
+constexpr int ROOK_OPEN_FILE_BONUS = 50;
+constexpr int ROOK_HALF_OPEN_FILE_BONUS = 25;
+
+/**
+ * Pawn shield of a castled king: the king's square, the three squares in front of it and the
+ * bonus for an own pawn on each of them.
+ */
+struct KingShield
+{
+    int kingSquare;
+    int pawnSquares[3];
+    int bonus[3];
+};
+
+// Kings on g1 and c1, and on g8 and c8; the same order as PawnEntry::whiteShield and blackShield
+constexpr KingShield WHITE_SHIELDS[2] = {{62, {55, 54, 53}, {20, 50, 50}}, {58, {50, 49, 48}, {50, 50, 15}}};
+constexpr KingShield BLACK_SHIELDS[2] = {{6, {13, 14, 15}, {50, 50, 15}}, {2, {8, 9, 10}, {15, 50, 50}}};
+
 Evaluation::Evaluation(std::shared_ptr<Board> board) : board(board) {}
 
 int Evaluation::evaluatePosition()
 {
+#ifdef BOTFISH_CHECK_EVAL
+    if (!board->verifyEvalTerms())
+        std::abort();
+#endif
+
+    // Middlegame and endgame terms are blended by the game phase instead of switching at a
+    // fixed piece count, so the score changes smoothly as material comes off
+    const EvalTerms &terms = board->evalTerms;
 
-    int materialScore = evaluateMaterial();
+    int materialScore = taperedScore(terms.middlegame, terms.endgame, terms.phase);
 
-    int positionalScore = evaluatePieceSquareTables();
+    const PawnEntry &pawnEntry = probePawnStructure();
 
-    int pawns = evaluatePassedPawns();
+    int pawns = pawnEntry.score;
 
-    int rooks = rookOnOpenFile();
+    int rooks = rookOnOpenFile(pawnEntry);
 
-    int castlingPawns = evaluateCastlingPawns();
+    // The pawn shield only matters while there are pieces left to attack the king
+    int castlingPawns = taperedScore(evaluateCastlingPawns(pawnEntry), 0, terms.phase);
 
     int rookInLineWithKing = evaluateRookInLineWithKing();
 
-    return materialScore + positionalScore + pawns + rooks + castlingPawns + rookInLineWithKing ;
+    return materialScore + pawns + rooks + castlingPawns + rookInLineWithKing ;
 }
 
-// Evaluates material balance
-int Evaluation::evaluateMaterial()
+/**
+ * Looks the pawn structure up in the pawn table and evaluates it on a miss, so the pawn terms
+ * are only computed when a pawn moved or was captured.
+ */
+const PawnEntry &Evaluation::probePawnStructure()
 {
-    int score = 0;
-
-    score += evaluatePieceSet(board->whitePawns, 100);
-    score += evaluatePieceSet(board->blackPawns, -100);
-    score += evaluatePieceSet(board->whiteKnights, 300);
-    score += evaluatePieceSet(board->blackKnights, -300);
-    score += evaluatePieceSet(board->whiteBishops, 320);
-    score += evaluatePieceSet(board->blackBishops, -320);
-    score += evaluatePieceSet(board->whiteRooks, 500);
-    score += evaluatePieceSet(board->blackRooks, -500);
-    score += evaluatePieceSet(board->whiteQueens, 900);
-    score += evaluatePieceSet(board->blackQueens, -900);
+    bool hit;
+    PawnEntry &entry = pawnTable.probe(board->pawnKey, hit);
+    if (!hit)
+    {
+        evaluatePawnStructure(entry);
+        return entry;
+    }
 
-    return score;
+#ifdef BOTFISH_CHECK_EVAL
+    PawnEntry expected;
+    evaluatePawnStructure(expected);
+    if (expected.score != entry.score || expected.openFiles != entry.openFiles ||
+        expected.halfOpenFiles[0] != entry.halfOpenFiles[0] || expected.halfOpenFiles[1] != entry.halfOpenFiles[1] ||
+        expected.whiteShield[0] != entry.whiteShield[0] || expected.whiteShield[1] != entry.whiteShield[1] ||
+        expected.blackShield[0] != entry.blackShield[0] || expected.blackShield[1] != entry.blackShield[1])
+    {
+        std::cerr << "Error: pawn table entry differs from a fresh evaluation in " << board->getFen() << std::endl;
+        std::abort();
+    }
+#endif
+    return entry;
 }
 
-int Evaluation::evaluatePassedPawns()
+/**
+ * Fills a pawn table entry for the board's current pawns.
+ */
+void Evaluation::evaluatePawnStructure(PawnEntry &entry)
 {
-    int score = 0;
+    uint64_t whitePawns = board->whitePawns.bitboard;
+    uint64_t blackPawns = board->blackPawns.bitboard;
+
+    entry.key = board->pawnKey;
+    entry.score = evaluatePawns(true) - evaluatePawns(false);
+    entry.halfOpenFiles[0] = ~fileFill(whitePawns);
+    entry.halfOpenFiles[1] = ~fileFill(blackPawns);
+    entry.openFiles = entry.halfOpenFiles[0] & entry.halfOpenFiles[1];
 
-    // Evaluate white passed pawns
-    for (int i = 0; i < 8; i++)
+    for (int i = 0; i < 2; i++)
     {
-        uint64_t whitePawnsMask = board->whitePawns.bitboard & (1ULL << i);
-        while (whitePawnsMask)
+        entry.whiteShield[i] = 0;
+        entry.blackShield[i] = 0;
+        for (int j = 0; j < 3; j++)
         {
-            int square = bitScanForward(whitePawnsMask);
-
-            if (isPassedPawn(square, true))
-            {
-                score += 50;
-            }
-            whitePawnsMask &= whitePawnsMask - 1;
+            if (whitePawns & (1ULL << WHITE_SHIELDS[i].pawnSquares[j]))
+                entry.whiteShield[i] += WHITE_SHIELDS[i].bonus[j];
+            if (blackPawns & (1ULL << BLACK_SHIELDS[i].pawnSquares[j]))
+                entry.blackShield[i] -= BLACK_SHIELDS[i].bonus[j];
         }
     }
+}
 
-    // Evaluate black passed pawns
-    for (int i = 0; i < 8; i++)
-    {
-        uint64_t blackPawnsMask = board->blackPawns.bitboard & (1ULL << i);
-        while (blackPawnsMask)
-        {
-            int square = bitScanForward(blackPawnsMask);
+/**
+ * Scores one side's pawns: a bonus for passed pawns, and penalties for isolated pawns, for
+ * pawns with an own pawn in front of them on the same file, and for backward pawns (no own
+ * pawn beside or behind them on an adjacent file, and the square in front is attacked by an
+ * enemy pawn).
+ *
+ * Every pawn is classified at once with file fills and shifts, so the cost does not depend
+ * on the number of pawns.
+ *
+ * @return The score from the given side's point of view.
+ */
+int Evaluation::evaluatePawns(bool white)
+{
+    uint64_t own = white ? board->whitePawns.bitboard : board->blackPawns.bitboard;
+    uint64_t enemy = white ? board->blackPawns.bitboard : board->whitePawns.bitboard;
 
-            if (isPassedPawn(square, false))
-            {
-                score -= 50;
-            }
-            blackPawnsMask &= blackPawnsMask - 1;
-        }
-    }
+    // Passed: no enemy pawn in front on the same or an adjacent file, and the front pawn of its file
+    uint64_t enemyFront = frontSpans(enemy, !white);
+    uint64_t stoppable = enemyFront | shiftWest(enemyFront) | shiftEast(enemyFront);
+    uint64_t passed = own & ~stoppable & ~rearSpans(own, white);
 
+    uint64_t ownFiles = fileFill(own);
+    uint64_t isolated = own & ~(shiftWest(ownFiles) | shiftEast(ownFiles));
+
+    // A pawn is supported from behind if an own pawn on an adjacent file is level with or behind it
+    uint64_t supportSpans = white ? northFill(own) : southFill(own);
+    uint64_t supported = shiftWest(supportSpans) | shiftEast(supportSpans);
+    uint64_t enemyAttacks = pawnAttacks(enemy, !white);
+    uint64_t stopAttacked = white ? enemyAttacks << 8 : enemyAttacks >> 8;
+    uint64_t backward = own & ~isolated & ~supported & stopAttacked;
+
+    uint64_t doubled = own & rearSpans(own, white);
+
+    int score = PASSED_PAWN_BONUS * static_cast<int>(_mm_popcnt_u64(passed)) -
+                ISOLATED_PAWN_PENALTY * static_cast<int>(_mm_popcnt_u64(isolated)) -
+                BACKWARD_PAWN_PENALTY * static_cast<int>(_mm_popcnt_u64(backward)) -
+                DOUBLED_PAWN_PENALTY * static_cast<int>(_mm_popcnt_u64(doubled));
+
+#ifdef BOTFISH_CHECK_EVAL
+    if (score != evaluatePawnsBySquare(white))
+    {
+        std::cerr << "Error: set-wise pawn score " << score << " differs from per-pawn score "
+                  << evaluatePawnsBySquare(white) << " in " << board->getFen() << std::endl;
+        std::abort();
+    }
+#endif
     return score;
 }
 
-int Evaluation::evaluateCastlingPawns()
+#ifdef BOTFISH_CHECK_EVAL
+/**
+ * Reference for evaluatePawns(): the same terms pawn by pawn from the per-square masks.
+ */
+int Evaluation::evaluatePawnsBySquare(bool white)
 {
-    int score = 0;
-    bool isEndgame = board->whitePawns.count() + board->blackPawns.count() 
-    + board->whiteBishops.count() + board->blackBishops.count() 
-    + board->whiteKnights.count() + board->blackKnights.count() + board->whiteQueens.count() 
-    + board->blackQueens.count() + board->whiteRooks.count() + board->blackRooks.count() < 15;
+    uint64_t own = white ? board->whitePawns.bitboard : board->blackPawns.bitboard;
+    uint64_t enemy = white ? board->blackPawns.bitboard : board->whitePawns.bitboard;
+    uint64_t enemyAttacks = pawnAttacks(enemy, !white);
+    int colour = white ? 0 : 1;
 
-    if(board->whiteKing.bitboard & (1ULL << 62) && !isEndgame)
-    {
-        if(board->whitePawns.bitboard & (1ULL << 55))
-        {
-            score += 20;
-        }
-        if(board->whitePawns.bitboard & (1ULL << 54))
-        {
-            score += 50;
-        }
-       
-        if(board->whitePawns.bitboard & (1ULL << 53))
-        {
-            score += 50;
-        }
-        
-    }
-    if(board->whiteKing.bitboard & (1ULL << 58) && !isEndgame)
+    int score = 0;
+    for (uint64_t pawns = own; pawns; pawns &= pawns - 1)
     {
-        if(board->whitePawns.bitboard & (1ULL << 50))
-        {
-            score += 50;
-        }
-      
-        if(board->whitePawns.bitboard & (1ULL << 49))
-        {
-            score += 50;
-        }
-      
-        if(board->whitePawns.bitboard & (1ULL << 48))
-        {
-            score += 15;
-        }
-       
-        
+        int square = bitScanForward(pawns);
+        uint64_t adjacentFiles = PAWN_MASKS.adjacentFiles[square % 8];
+        uint64_t forwardSpan = PAWN_MASKS.forwardSpan[colour][square];
+        uint64_t stopSquare = white ? (1ULL << square) >> 8 : (1ULL << square) << 8;
+
+        if ((enemy & PAWN_MASKS.passedPawn[colour][square]) == 0 && (own & forwardSpan) == 0)
+            score += PASSED_PAWN_BONUS;
+        if ((own & adjacentFiles) == 0)
+            score -= ISOLATED_PAWN_PENALTY;
+        else if ((own & adjacentFiles & ~PAWN_MASKS.passedPawn[colour][square]) == 0 && (enemyAttacks & stopSquare))
+            score -= BACKWARD_PAWN_PENALTY;
+        if (own & forwardSpan)
+            score -= DOUBLED_PAWN_PENALTY;
     }
-    if(board->blackKing.bitboard & (1ULL << 2) && !isEndgame)
-    {
+    return score;
+}
+#endif
 
-        if(board->blackPawns.bitboard & (1ULL << 8))
-        {
-            score -= 15;
-        }
-        if(board->blackPawns.bitboard & (1ULL << 9))
-        {
-            score -= 50;
-        }
-        if(board->blackPawns.bitboard & (1ULL << 10))
-        {
-            score -= 50;
-        }
-        
-    }
-    if(board->blackKing.bitboard & (1ULL << 6) && !isEndgame)
+int Evaluation::evaluateCastlingPawns(const PawnEntry &pawnEntry)
+{
+    int score = 0;
+
+    for (int i = 0; i < 2; i++)
     {
-        if(board->blackPawns.bitboard & (1ULL << 13))
+        if (board->whiteKing.bitboard & (1ULL << WHITE_SHIELDS[i].kingSquare))
         {
-            score -= 50;
+            score += pawnEntry.whiteShield[i];
         }
-        if(board->blackPawns.bitboard & (1ULL << 14))
+        if (board->blackKing.bitboard & (1ULL << BLACK_SHIELDS[i].kingSquare))
         {
-            score -= 50;
-        }
-        if(board->blackPawns.bitboard & (1ULL << 15))
-        {
-            score -= 15;
+            score += pawnEntry.blackShield[i];
         }
     }
-    
+
     return score;
 }
 
@@ -195,123 +248,26 @@ int Evaluation::evaluateRookInLineWithKing()
 }
 
 
-// Helper function to determine if a pawn is a passed pawn
-bool Evaluation::isPassedPawn(int square, bool isWhite)
-{
-    int file = square % 8;
-    uint64_t opponentPawns = isWhite ? board->blackPawns.bitboard : board->whitePawns.bitboard;
-
-    // Check if any opponent pawns are on the same file or adjacent files
-    // For white pawns, the opponent's pawns should not be in the same or adjacent files
-    // For black pawns, the opponent's pawns should not be in the same or adjacent files
-    uint64_t blockMask = (1ULL << file) | (1ULL << (file - 1)) | (1ULL << (file + 1));
-
-    if ((opponentPawns & blockMask) == 0)
-    {
-        return true;
-    }
-    return false;
-}
-
-int Evaluation::evaluatePieceSquareTables()
-{
-    int score = 0;
-
-    bool isEndgame = board->whitePawns.count() + board->blackPawns.count() + board->whiteBishops.count() + board->blackBishops.count() + board->whiteKnights.count() + board->blackKnights.count() + board->whiteQueens.count() + board->blackQueens.count() + board->whiteRooks.count() + board->blackRooks.count() < 15;
-
-    score += evaluatePiecePosition(board->whitePawns, isEndgame ? PawnsEnd : Pawns);
-    score += evaluatePiecePosition(board->blackPawns, isEndgame ? PawnsEnd : Pawns, true); // Mirrored for Black
-
-    score += evaluatePiecePosition(board->whiteKnights, Knights);
-    score += evaluatePiecePosition(board->blackKnights, Knights, true);
-
-    score += evaluatePiecePosition(board->whiteRooks, Rooks);
-    score += evaluatePiecePosition(board->blackRooks, Rooks, true);
-
-    score += evaluatePiecePosition(board->whiteBishops, Bishops);
-    score += evaluatePiecePosition(board->blackBishops, Bishops, true);
-
-    score += evaluatePiecePosition(board->whiteKing, isEndgame ? KingEnd : KingSafety);
-    score += evaluatePiecePosition(board->blackKing, isEndgame ? KingEnd : KingSafety, true);
-
-    return score;
-}
-
-int Evaluation::rookOnOpenFile()
+int Evaluation::rookOnOpenFile(const PawnEntry &pawnEntry)
 {
-    uint64_t whiteRooks = board->whiteRooks.bitboard;
-    uint64_t blackRooks = board->blackRooks.bitboard;
-    uint64_t allPawns = board->whitePawns.bitboard | board->blackPawns.bitboard;
-
     int score = 0;
 
-    uint64_t whitePawns = board->whitePawns.bitboard;
-    uint64_t blackPawns = board->blackPawns.bitboard;
-
-    while (whiteRooks)
+    for (uint64_t whiteRooks = board->whiteRooks.bitboard; whiteRooks; whiteRooks &= whiteRooks - 1)
     {
-        int square = bitScanForward(whiteRooks);
-        int file = square % 8;
-        uint64_t fileMask = getFileMask(file);
-
-        if ((allPawns & fileMask) == 0)
-        { // Open file
-            score += 50;
-        }
-        else if ((whitePawns & fileMask) == 0)
-        { // Semi-open (no white pawns)
-            score += 25;
-        }
-
-        whiteRooks &= whiteRooks - 1;
-    }
-
-    while (blackRooks)
-    {
-        int square = bitScanForward(blackRooks);
-        int file = square % 8;
-        uint64_t fileMask = getFileMask(file);
-
-        if ((allPawns & fileMask) == 0)
-        { // Open file
-            score -= 50;
-        }
-        else if ((blackPawns & fileMask) == 0)
-        { // Semi-open (no black pawns)
-            score -= 25;
-        }
-
-        blackRooks &= blackRooks - 1;
+        uint64_t rook = 1ULL << bitScanForward(whiteRooks);
+        if (pawnEntry.openFiles & rook)
+            score += ROOK_OPEN_FILE_BONUS;
+        else if (pawnEntry.halfOpenFiles[0] & rook)
+            score += ROOK_HALF_OPEN_FILE_BONUS;
     }
-    return score;
-}
-
-uint64_t Evaluation::getFileMask(int file)
-{
-    uint64_t fileMask = 0x0101010101010101ULL; // Column A mask
-    return fileMask << file;                   // Shift left to get the correct file
-}
-
-int Evaluation::evaluatePieceSet(Bitboard &bitboard, int value)
-{
-   return bitboard.count() * value;
-}
-
-int Evaluation::evaluatePiecePosition(Bitboard &bitboard, const int table[64], bool mirror)
-{
-    uint64_t bitMask = bitboard.bitboard;
-    int score = 0;
 
-    while (bitMask)
+    for (uint64_t blackRooks = board->blackRooks.bitboard; blackRooks; blackRooks &= blackRooks - 1)
     {
-        int square = bitScanForward(bitMask);
-        // char piece = board->getPieceAtSquare(square);
-
-        int position = mirror ? -table[mirrorIndex(square)] : table[square];
-
-        score += position;
-
-        bitMask &= bitMask - 1;
+        uint64_t rook = 1ULL << bitScanForward(blackRooks);
+        if (pawnEntry.openFiles & rook)
+            score -= ROOK_OPEN_FILE_BONUS;
+        else if (pawnEntry.halfOpenFiles[1] & rook)
+            score -= ROOK_HALF_OPEN_FILE_BONUS;
     }
 
     return score;
@@ -326,9 +282,3 @@ int Evaluation::bitScanForward(uint64_t bitboard)
     }
     return -1;
 }
-
-// Mirrors square index for Black pieces
-inline int Evaluation::mirrorIndex(int square)
-{
-    return square ^ 63;
-}
@@ -1,87 +1,451 @@
 #include "Node.h"
 #include "Board.h"
 #include "Evaluation.h"
+#include "Score.h"
+#include "SearchParameters.h"
 
-constexpr int NEG_INF = std::numeric_limits<int>::min();
-constexpr int POS_INF = std::numeric_limits<int>::max();
+#include <algorithm>
+#include <cmath>
+
+constexpr int POS_INF = SCORE_INFINITE;
+constexpr int NEG_INF = -SCORE_INFINITE;
 constexpr Move NULL_MOVE{-1, -1};
 constexpr Move RESIGN_MOVE{-4, -1};
 constexpr Move STALEMATE_MOVE{-2, -1};
 
+// Half width of the first aspiration window and the depth from which windows are used
+constexpr int ASPIRATION_WINDOW = 25;
+constexpr int ASPIRATION_MIN_DEPTH = 4;
+
+// Null-move pruning is tried from this depth on; from NULL_MOVE_VERIFY_DEPTH a fail-high is
+// confirmed by a reduced search without null moves before it is trusted (zugzwang guard)
+constexpr int NULL_MOVE_MIN_DEPTH = 3;
+constexpr int NULL_MOVE_VERIFY_DEPTH = 10;
+
+// From this depth, a PV or cut node without a hash move is searched one ply shallower
+// (internal iterative reduction). Built with BOTFISH_IID, it instead runs a search
+// IID_REDUCTION plies shallower first to find a move to order first (internal iterative deepening).
+constexpr int IIR_MIN_DEPTH = 4;
+constexpr int IID_REDUCTION = 2;
+
+// Largest positional swing a capture can bring on top of the captured material
+constexpr int DELTA_MARGIN = 200;
+
+// Up to SEE_PRUNE_DEPTH, later moves that lose more than the margin in a static exchange are
+// skipped: captures by SEE_CAPTURE_MARGIN * depth^2, quiets (hanging the moved piece) by SEE_QUIET_MARGIN * depth
+constexpr int SEE_PRUNE_DEPTH = 4;
+constexpr int SEE_CAPTURE_MARGIN = 90;
+constexpr int SEE_QUIET_MARGIN = 60;
+
+// Late move reductions apply to quiet moves from LMR_MIN_DEPTH on. The base reduction is
+// LMR_BASE + ln(depth) * ln(move number) / LMR_DIVISOR; each LMR_HISTORY_DIVISOR of history
+// score takes one ply off (or adds one), up to two
+constexpr int LMR_MIN_DEPTH = 3;
+constexpr double LMR_BASE = 0.5;
+constexpr double LMR_DIVISOR = 2.25;
+constexpr int LMR_HISTORY_DIVISOR = 8192;
+
+/**
+ * @brief Base late move reduction for a move searched as moveNumber-th (0 based) at depth.
+ */
+static int lateMoveReduction(int depth, int moveNumber)
+{
+    static const auto table = []()
+    {
+        std::array<std::array<int, 64>, 64> reductions{};
+        for (int d = 1; d < 64; ++d)
+        {
+            for (int m = 1; m < 64; ++m)
+            {
+                reductions[d][m] = static_cast<int>(LMR_BASE + std::log(d) * std::log(m) / LMR_DIVISOR);
+            }
+        }
+        return reductions;
+    }();
+
+    return table[std::min(depth, 63)][std::min(moveNumber, 63)];
+}
+
+// Move ordering: the previous iteration's PV move, hash move, then winning and even captures
+// and promotions, then killers, then quiets by history, then captures that lose material
+constexpr int PV_MOVE_SCORE = (1 << 30) + 1;
+constexpr int TT_MOVE_SCORE = 1 << 30;
+constexpr int CAPTURE_SCORE = 1 << 28;
+constexpr int BAD_CAPTURE_SCORE = -(1 << 28);
+constexpr int KILLER_SCORE = 1 << 27;
+constexpr int COUNTER_MOVE_SCORE = KILLER_SCORE - 2;
+constexpr int HISTORY_MAX = 16384;
+
+/**
+ * @brief Returns true for captures (including en passant) and promotions.
+ */
+static bool isTactical(Board &board, Move move)
+{
+    char piece = board.getPieceAtSquare(move.from);
+    if (board.getPieceAtSquare(move.to) != ' ')
+        return true;
+    return std::tolower(piece) == 'p' && ((move.from % 8) != (move.to % 8) || move.to < 8 || move.to >= 56);
+}
+
+/**
+ * @brief Clears the killer moves and halves the history left over from the last search.
+ */
+void Node::newSearch()
+{
+    std::fill(&killers[0][0], &killers[0][0] + (MAX_PLY + 1) * 2, NULL_MOVE);
+    int *values = &history[0][0][0];
+    for (int i = 0; i < 2 * 64 * 64; i++)
+    {
+        values[i] /= 2;
+    }
+    gameOver = false;
+}
+
+/**
+ * @brief Forgets everything learned in earlier searches, so the next search does not depend on them.
+ */
+void Node::newGame()
+{
+    std::fill(&killers[0][0], &killers[0][0] + (MAX_PLY + 1) * 2, NULL_MOVE);
+    std::fill(&counterMoves[0][0], &counterMoves[0][0] + 12 * 64, NULL_MOVE);
+    std::fill(&history[0][0][0], &history[0][0][0] + 2 * 64 * 64, 0);
+    for (auto &table : continuationHistory)
+    {
+        std::fill(table.begin(), table.end(), PieceToHistory{});
+    }
+    gameOver = false;
+}
+
 /**
  * @brief Implements Iterative Deepening Depth-First Search (IDDFS).
  *
- * Iterative deepening repeatedly calls the minimax function, incrementally increasing depth.
+ * Iterative deepening repeatedly calls the negamax search, incrementally increasing depth.
  * This ensures that shallower depths guide deeper searches, improving efficiency and move ordering.
  *
+ * Each iteration searches the root through aspirationSearch. With multiPV above 1 the root
+ * is searched again for every further line with the best moves found so far excluded; the
+ * repeated searches run on a table and history already filled by the first one, so each
+ * extra line costs much less than a full search.
+ *
  * @param board Shared pointer to the current board state.
  * @param maxDepth Maximum search depth.
- * @param maximizingPlayer True if the current player is maximizing, false if minimizing.
+ * @param maximizingPlayer True if white is to move; must match board->whiteToMove.
  * @param evaluate Reference to the evaluation function.
- * @return Best move found as a pair: (evaluation score, (from, to)).
+ * @return Best move found as a pair: (evaluation score from white's point of view, (from, to)).
  */
 std::pair<int, Move> Node::iterativeDeepening(std::shared_ptr<Board> board, int maxDepth, bool maximizingPlayer, Evaluation &evaluate)
 {
     Move bestMove = {-5, -1};
     int bestEval = maximizingPlayer ? NEG_INF : POS_INF;
 
+    nodesExplored = 0;
+    quiescenceNodes = 0;
+    aspirationResearches = 0;
+    betaCutoffs = 0;
+    firstMoveCutoffs = 0;
+    lmrResearches = 0;
+    extensions = 0;
+    branchingFactor = 0.0;
+    completedDepth = 0;
+    aborted = false;
+    firstReportTime = {};
+    searchStart = std::chrono::steady_clock::now();
+    SEARCH_STAT(stats.clear());
+    previousPv.clear();
+
+    int previousScore = 0;
+    int bestMoveStability = 0;
+    uint64_t nodesBefore = 0;
+    uint64_t previousIterationNodes = 0;
+    uint64_t lmrResearchesBefore = 0;
+    uint64_t extensionsBefore = 0;
+
+    // Never ask for more lines than there are moves to search, so every line has a move
+    Move rootMoves[256];
+    int legalRootMoves = board->getAllLegalMovesAsArray(rootMoves, board->whiteToMove).from;
+    rootExcluded.clear();
+    int rootMoveCount = static_cast<int>(std::count_if(rootMoves, rootMoves + legalRootMoves, [&](const Move &move)
+                                                       { return isSearchedRootMove(move); }));
+    int lineCount = std::clamp(multiPV, 1, std::max(rootMoveCount, 1));
+    rootLines.assign(lineCount, {NULL_MOVE, 0, {}});
+
     for (int depth = 1; depth <= maxDepth; depth++)
     {
         gameOver = false;
-        nodesExplored = 0;
-        std::pair<int, Move> result = minimax(*board, depth, maximizingPlayer,
-                                              NEG_INF,
-                                              POS_INF,
-                                              evaluate);
-        bestEval = result.first;
-        bestMove = result.second;
+        rootDepth = depth;
+        selDepth = 0;
 
-        if (bestEval == std::numeric_limits<int>::max() || bestEval == std::numeric_limits<int>::min() || board->isThreefoldRepetition())
+        // Only the first line follows the previous iteration's principal variation
+        onPv[0] = true;
+        int researches = 0;
+        std::pair<int, Move> result = aspirationSearch(*board, depth, previousScore, evaluate, researches);
+
+        // MultiPV: every further line is the best move once the moves of the lines above are excluded
+        std::vector<RootLine> lines = {{result.second, result.first, rootPv(result.second)}};
+        onPv[0] = false;
+        for (int line = 1; line < lineCount && !aborted; line++)
+        {
+            rootExcluded.push_back(lines.back().move);
+            auto lineResult = aspirationSearch(*board, depth, rootLines[line].score, evaluate, researches);
+            lines.push_back({lineResult.second, lineResult.first, rootPv(lineResult.second)});
+        }
+        rootExcluded.clear();
+        aspirationResearches += researches;
+
+        if (aborted)
         {
             break;
         }
-        std::cout << "Depth " << depth << " completed. Best Move: (" << bestMove.from
-                  << " -> " << bestMove.to << "), Eval: " << bestEval
-                  << ", Nodes explored: " << nodesExplored << std::endl;
-    }
+        // Each line has its own aspiration window, so a later line can outscore the first
+        std::stable_sort(lines.begin(), lines.end(), [](const RootLine &a, const RootLine &b)
+                         { return a.score > b.score; });
+        rootLines = lines;
+        const RootLine &best = rootLines[0];
+        previousPv = best.pv;
+        completedDepth = depth;
+        uint64_t iterationNodes = nodesExplored - nodesBefore;
+        if (previousIterationNodes > 0)
+        {
+            branchingFactor = static_cast<double>(iterationNodes) / previousIterationNodes;
+        }
+        previousIterationNodes = iterationNodes;
+        nodesBefore = nodesExplored;
+        SEARCH_STAT(stats.iterations.push_back({depth, nodesExplored,
+                                                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - searchStart).count(),
+                                                branchingFactor}));
+        int scoreDrop = depth > 1 ? previousScore - best.score : 0;
+        bestMoveStability = depth > 1 && best.move == bestMove ? bestMoveStability + 1 : 0;
+        previousScore = best.score;
+        bestEval = maximizingPlayer ? best.score : -best.score;
+        bestMove = best.move;
 
-    std::cout << "Iterative Deepening Complete. Best Move: (" << bestMove.from << " -> " << bestMove.to << "), Final Eval: " << bestEval << std::endl;
-    std::cout << "Nodes: " << nodesExplored << std::endl;
+        if (verbose)
+        {
+            printRootLines(*board, depth);
+            // Re-search and extension counts of this iteration, for tuning the windows and reductions
+            std::cout << "info string depth " << depth << " aspiration researches " << researches
+                      << " lmr researches " << (lmrResearches - lmrResearchesBefore)
+                      << " extensions " << (extensions - extensionsBefore) << std::endl;
+        }
+        lmrResearchesBefore = lmrResearches;
+        extensionsBefore = extensions;
+        if (depth == 1)
+        {
+            firstReportTime = std::chrono::steady_clock::now();
+        }
+        if (isMateScore(bestEval) || board->isThreefoldRepetition())
+        {
+            break;
+        }
+        if (timeManager && timeManager->softLimitReached(bestMoveStability, scoreDrop))
+        {
+            break;
+        }
+    }
 
+    SEARCH_STAT(stats.nodes = nodesExplored);
+    SEARCH_STAT(stats.quiescenceNodes = quiescenceNodes);
     return {bestEval, bestMove};
 }
 
 /**
- * @brief Minimax search with alpha-beta pruning.
+ * @brief Searches the root with an aspiration window around the previous iteration's score.
  *
- * This function searches for the best move up to a given depth, pruning
- * unpromising branches to improve performance.
+ * From ASPIRATION_MIN_DEPTH on, the search starts with a narrow window around previousScore.
+ * A result outside it is searched again with the failing side pushed out by a delta that
+ * grows by half each time, until the score lands inside the window.
  *
- * @param board Shared pointer to the current board state.
+ * @param researches Incremented for every repeated search.
+ * @return Score from the side to move's point of view and best move; undefined when aborted.
+ */
+std::pair<int, Move> Node::aspirationSearch(Board &board, int depth, int previousScore, Evaluation &evaluate, int &researches)
+{
+    int delta = ASPIRATION_WINDOW;
+    int alpha = NEG_INF;
+    int beta = POS_INF;
+    if (depth >= ASPIRATION_MIN_DEPTH && !isMateScore(previousScore))
+    {
+        alpha = std::max(previousScore - delta, NEG_INF);
+        beta = std::min(previousScore + delta, POS_INF);
+    }
+
+    while (true)
+    {
+        std::pair<int, Move> result = negamax<Root>(board, depth, alpha, beta, evaluate, 0, false);
+        if (aborted)
+        {
+            return result;
+        }
+
+        if (result.first <= alpha)
+        {
+            beta = (alpha + beta) / 2;
+            alpha = std::max(result.first - delta, NEG_INF);
+        }
+        else if (result.first >= beta)
+        {
+            beta = std::min(result.first + delta, POS_INF);
+        }
+        else
+        {
+            return result;
+        }
+
+        researches++;
+        delta += delta / 2;
+    }
+}
+
+/**
+ * @brief Whether move is searched at the root: in searchMoves if that is set, and not taken by an earlier MultiPV line.
+ */
+bool Node::isSearchedRootMove(Move move) const
+{
+    if (!searchMoves.empty() && std::find(searchMoves.begin(), searchMoves.end(), move) == searchMoves.end())
+        return false;
+    return std::find(rootExcluded.begin(), rootExcluded.end(), move) == rootExcluded.end();
+}
+
+/**
+ * @brief Copies the root's line out of the triangular PV table.
+ *
+ * The line can be missing when the move came from an aborted or failed-low search; the
+ * move alone is returned then.
+ */
+std::vector<Move> Node::rootPv(Move best) const
+{
+    if (pvLength[0] == 0 || pvTable[0][0] != best)
+        return {best};
+    return std::vector<Move>(pvTable[0].begin(), pvTable[0].begin() + pvLength[0]);
+}
+
+/**
+ * @brief Makes move followed by the child's line the principal variation at ply.
+ */
+void Node::updatePv(int ply, Move move)
+{
+    auto &line = pvTable[ply];
+    const auto &childLine = pvTable[ply + 1];
+
+    line[ply] = move;
+    int length = std::max(pvLength[ply + 1], ply + 1);
+    for (int p = ply + 1; p < length; p++)
+    {
+        line[p] = childLine[p];
+    }
+    pvLength[ply] = length;
+}
+
+/**
+ * @brief Prints one UCI info line per MultiPV line of the last completed iteration.
+ *
+ * Scores are from the side to move's point of view, "mate n" when a mate was found. Without
+ * a legal move the line is "mate 0" when checkmated and "cp 0" when stalemated, with an empty PV.
+ */
+void Node::printRootLines(Board &board, int depth)
+{
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - searchStart).count();
+    uint64_t nps = nodesExplored * 1000 / std::max<long long>(elapsedMs, 1);
+
+    for (size_t i = 0; i < rootLines.size(); i++)
+    {
+        int lineScore = rootLines[i].score;
+        std::cout << "info depth " << depth << " seldepth " << selDepth << " multipv " << (i + 1) << " score ";
+        if (rootLines[i].move.from < 0)
+            std::cout << (board.isKingInCheck(board.whiteToMove) ? "mate 0" : "cp 0");
+        else if (isMateScore(lineScore))
+            std::cout << "mate " << mateInMoves(lineScore);
+        else
+            std::cout << "cp " << lineScore;
+        std::cout << " nodes " << nodesExplored << " nps " << nps << " time " << elapsedMs;
+
+        for (size_t m = 0; m < rootLines[i].pv.size() && rootLines[i].pv[m].from >= 0; m++)
+        {
+            std::cout << (m == 0 ? " pv " : " ") << board.moveToString(rootLines[i].pv[m].from, rootLines[i].pv[m].to);
+        }
+        std::cout << std::endl;
+    }
+}
+
+/**
+ * Only checked once depth 1 has completed so there is always a move to play. The node
+ * limit is checked at every node so that a node-limited search always stops at the same
+ * node; the flag and the clock only every 2048 nodes.
+ */
+void Node::checkStop()
+{
+    if (completedDepth == 0) [[unlikely]]
+        return;
+
+    if (nodeLimit && nodesExplored >= nodeLimit) [[unlikely]]
+    {
+        aborted = true;
+        return;
+    }
+
+    if ((nodesExplored & 2047) != 0) [[likely]]
+        return;
+
+    if ((stopFlag && stopFlag->load(std::memory_order_relaxed)) || (timeManager && timeManager->hardLimitReached()))
+    {
+        aborted = true;
+    }
+}
+
+/**
+ * @brief Negamax search with alpha-beta pruning and principal variation search.
+ *
+ * Scores are always from the point of view of the side to move. The first move of a node
+ * is searched with the full window; every later move gets a zero window around alpha and
+ * is searched again with the full window only if it fails high inside a PV node. Late
+ * quiet moves start shallower by the amount from the reduction table, adjusted for the
+ * node and move type, and are re-searched at full depth when they beat alpha.
+ *
+ * @tparam nodeType Root, PV or NonPV. Only PV nodes (including the root) ever have an open
+ *                  window, so the full-window re-search compiles out of NonPV nodes.
+ * @param board Current board state.
  * @param depth Remaining search depth.
- * @param maximizingPlayer True if maximizing, false if minimizing.
- * @param alpha Alpha pruning value.
- * @param beta Beta pruning value.
+ * @param alpha Lower bound of the window.
+ * @param beta Upper bound of the window.
  * @param evaluate Reference to the evaluation function.
- * @return Best move as a pair: (evaluation score, (from, to)).
+ * @param ply Distance from the root, used to score mates by their length.
+ * @param cutNode True for zero-window nodes expected to fail high.
+ * @return Best score and move as a pair: (score, (from, to)).
  */
-std::pair<int, Move> Node::minimax(Board &board, int depth, bool maximizingPlayer, int alpha, int beta, Evaluation &evaluate)
+template <NodeType nodeType>
+std::pair<int, Move> Node::negamax(Board &board, int depth, int alpha, int beta, Evaluation &evaluate, int ply, bool cutNode)
 {
+    constexpr bool pvNode = nodeType != NonPV;
+    constexpr bool rootNode = nodeType == Root;
 
     LastMove lastMove;
 
-    if (depth == 0)
+    // A singular search revisits this ply and must keep the line found here so far
+    if (excludedMoves[ply].from < 0)
+        pvLength[ply] = ply;
+
+    if (depth <= 0)
+    {
+        return {quiescence(board, alpha, beta, evaluate, ply), NULL_MOVE};
+    }
+
+    nodesExplored++;
+    selDepth = std::max(selDepth, ply);
+
+    checkStop();
+    if (aborted) [[unlikely]]
     {
-        int eval = evaluate.evaluatePosition();
-        return {eval, {NULL_MOVE}};
+        return {0, NULL_MOVE};
     }
 
-    if (board.isThreefoldRepetition())
+    if (!rootNode && board.isThreefoldRepetition())
     {
-        if (maximizingPlayer)
-            return {alpha >= 0 ? -30 : 0, NULL_MOVE};
-        else
-            return {beta <= 0 ? 30 : 0, NULL_MOVE};
+        return {alpha >= 0 ? -30 : 0, NULL_MOVE};
+    }
+
+    if (ply >= MAX_PLY) [[unlikely]]
+    {
+        return {board.whiteToMove ? evaluate.evaluatePosition() : -evaluate.evaluatePosition(), NULL_MOVE};
     }
 
     board.moveCount = 0;
@@ -91,41 +455,119 @@ std::pair<int, Move> Node::minimax(Board &board, int depth, bool maximizingPlaye
 
     TTEntry entry;
 
-    // Probe the transposition table
-    if (board.probeTranspositionTable(positionHash, depth, alpha, beta, entry))
+    // A singular extension search revisits this position without its TT move, so it must
+    // neither take a cutoff from nor overwrite the entry of the full search
+    Move excludedMove = excludedMoves[ply];
+    bool excluded = excludedMove.from >= 0;
+
+    // Cutoffs from the table would cut the principal variation short, so PV nodes search on
+    bool ttUsable = board.probeTranspositionTable(positionHash, depth, scoreToTT(alpha, ply), scoreToTT(beta, ply), entry);
+    SEARCH_STAT(stats.ttProbe(depth, entry.hash == positionHash, !pvNode && !excluded && ttUsable));
+    if (!pvNode && !excluded && ttUsable)
+    {
+        return {scoreFromTT(entry.evaluation, ply), {entry.bestFrom, entry.bestTo}};
+    }
+    Move ttMove = {entry.bestFrom, entry.bestTo};
+
+    bool white = board.whiteToMove;
+    bool inCheck = board.isKingInCheck(white);
+    int staticEval = inCheck ? NEG_INF : (white ? evaluate.evaluatePosition() : -evaluate.evaluatePosition());
+    const SearchParameters &params = searchParameters;
+
+    // Improving: our static eval rose since our previous move (always assumed after a check there)
+    plyEvals[ply] = staticEval;
+    bool improving = !inCheck && ply >= 2 && staticEval > plyEvals[ply - 2];
+
+    // Reverse futility: so far above beta that the opponent cannot catch up within depth plies
+    if (!pvNode && !inCheck && !excluded && depth <= params.reverseFutilityDepth && !isMateScore(beta) &&
+        staticEval - params.reverseFutilityMargin * depth >= beta)
+    {
+        return {staticEval, NULL_MOVE};
+    }
+
+    // Razoring: so far below alpha that only tactics can help, so let quiescence decide
+    if (!pvNode && !inCheck && !excluded && depth <= params.razorDepth &&
+        staticEval + params.razorBase + params.razorMargin * depth < alpha)
     {
-        int transpositionEval = entry.evaluation;
-        if (depth <= entry.depth)
+        int razorScore = quiescence(board, alpha - 1, alpha, evaluate, ply);
+        if (aborted) [[unlikely]]
         {
-            if (entry.flag == TTFlag::EXACT) [[likely]]
-            {
-                return {entry.evaluation, {entry.bestFrom, entry.bestTo}};
-            }
-            else if (entry.flag == TTFlag::LOWERBOUND && transpositionEval > alpha)
-            {
-                return {entry.evaluation, {entry.bestFrom, entry.bestTo}};
-            }
-            else if (entry.flag == TTFlag::UPPERBOUND && transpositionEval < beta)
+            return {0, NULL_MOVE};
+        }
+        if (razorScore < alpha)
+            return {razorScore, NULL_MOVE};
+    }
+
+    // Null-move pruning: if passing the turn still fails high, some real move will too.
+    // Skipped in check, after another null move, and without pieces, where zugzwang is common.
+    if (!pvNode && !inCheck && !excluded && depth >= NULL_MOVE_MIN_DEPTH && ply >= nullMoveMinPly &&
+        !nullMoveAt[ply - 1] && !isMateScore(beta) && board.hasNonPawnMaterial(white) &&
+        staticEval >= beta)
+    {
+        int nullDepth = depth - 1 - (3 + depth / 6);
+
+        plyPieces[ply] = -1;
+        plyCaptures[ply] = false;
+        onPv[ply + 1] = false;
+        NullMoveState state = board.makeNullMove();
+        nullMoveAt[ply] = true;
+        int nullScore = -negamax<NonPV>(board, nullDepth, -beta, -beta + 1, evaluate, ply + 1, !cutNode).first;
+        nullMoveAt[ply] = false;
+        board.undoNullMove(state);
+        SEARCH_STAT(stats.nullMove(nullScore >= beta));
+
+        if (aborted) [[unlikely]]
+        {
+            return {0, NULL_MOVE};
+        }
+
+        if (nullScore >= beta)
+        {
+            if (isMateScore(nullScore))
+                nullScore = beta;
+
+            if (depth < NULL_MOVE_VERIFY_DEPTH)
+                return {nullScore, NULL_MOVE};
+
+            int savedMinPly = nullMoveMinPly;
+            nullMoveMinPly = ply + 3 * nullDepth / 4;
+            int verified = negamax<NonPV>(board, nullDepth, beta - 1, beta, evaluate, ply, false).first;
+            nullMoveMinPly = savedMinPly;
+
+            if (aborted) [[unlikely]]
             {
-                return {entry.evaluation, {entry.bestFrom, entry.bestTo}};
+                return {0, NULL_MOVE};
             }
+            if (verified >= beta)
+                return {nullScore, NULL_MOVE};
+        }
+    }
+
+    // Without a hash move the node was never searched well, so ordering will be poor
+    if ((pvNode || cutNode) && !excluded && ttMove.from < 0 && depth >= IIR_MIN_DEPTH)
+    {
+#ifdef BOTFISH_IID
+        ttMove = negamax<nodeType>(board, depth - IID_REDUCTION, alpha, beta, evaluate, ply, cutNode).second;
+        if (aborted) [[unlikely]]
+        {
+            return {0, NULL_MOVE};
         }
+#else
+        depth--;
+#endif
     }
 
     Move moves[256];
-    Move moveData = board.getAllLegalMovesAsArray(moves, maximizingPlayer);
+    Move moveData = board.getAllLegalMovesAsArray(moves, white);
     int moveCount = moveData.from;
-    int nonCaptureStart = moveData.to;
 
     if (moveCount == 0)
     {
         gameOver = true;
-        nodesExplored++;
 
-        if (board.isKingInCheck(maximizingPlayer)) [[unlikely]]
+        if (inCheck) [[unlikely]]
         {
-            int eval = maximizingPlayer ? NEG_INF : POS_INF;
-            return {eval, NULL_MOVE};
+            return {matedIn(ply), NULL_MOVE};
         }
         else [[likely]]
         {
@@ -133,110 +575,471 @@ std::pair<int, Move> Node::minimax(Board &board, int depth, bool maximizingPlaye
         }
     }
 
-    int curr = 0;
-    for (int j = 0; j < moveCount; ++j)
+    int scores[256];
+    scoreMoves(board, moves, scores, moveCount, ttMove, ply);
+
+    Move quietsTried[256];
+    int quietCount = 0;
+    int movesSearched = 0;
+
+    int originalAlpha = alpha;
+    int bestScore = NEG_INF;
+    Move bestMove = {moves[0].from, moves[0].to};
+
+    // Late move pruning: past this many moves, quiet moves are no longer searched at low depth
+    int lateMoveLimit = (params.lateMoveBase + depth * depth) / (improving ? 1 : 2);
+
+    for (int i = 0; i < moveCount; ++i)
     {
-        if (std::find(std::begin(previousBestMoves),
-                      std::end(previousBestMoves), moves[j]) != std::end(previousBestMoves))
+        // Selection sort step: only the moves actually searched before a cutoff get sorted
+        int next = i;
+        for (int j = i + 1; j < moveCount; ++j)
         {
-            std::swap(moves[curr++], moves[j]);
+            if (scores[j] > scores[next])
+                next = j;
         }
-    }
+        std::swap(moves[i], moves[next]);
+        std::swap(scores[i], scores[next]);
 
-    if (killerMoves[depth] != NULL_MOVE)
-    {
-        Move killerMove = killerMoves[depth];
+        int moveFrom = moves[i].from;
+        int moveTo = moves[i].to;
+        if (excluded && moves[i] == excludedMove)
+            continue;
+        if (rootNode && !isSearchedRootMove(moves[i]))
+            continue;
+
+        bool quiet = !isTactical(board, moves[i]);
 
-        auto it = std::find(moves, moves + moveCount, killerMove);
-        if (it != moves + moveCount)
+        // Quiet checks are forcing, so the quiet move pruning below leaves them alone
+        bool prunable = quiet && !board.givesCheck(moves[i]);
+
+        if (!rootNode && prunable && !inCheck && bestScore > -SCORE_MATE_IN_MAX_PLY)
         {
-            std::swap(moves[0], *it);
+            bool refutation = scores[i] >= COUNTER_MOVE_SCORE && scores[i] <= KILLER_SCORE;
+
+            if (depth <= params.lateMoveDepth && i >= lateMoveLimit)
+                continue;
+
+            // History pruning: quiets that keep failing in this context are not worth a search
+            if (!refutation && i > 0 && depth <= params.historyPruningDepth && scores[i] < -params.historyPruningMargin * depth)
+                continue;
         }
-    }
 
-    int bestScore = maximizingPlayer ? NEG_INF : POS_INF;
-    Move bestMove = {moves[0].from, moves[0].to};
+        // Futility: a quiet move cannot lift a static eval this far below alpha
+        if (!pvNode && prunable && i > 0 && !inCheck && depth <= params.futilityDepth && bestScore > -SCORE_MATE_IN_MAX_PLY &&
+            staticEval + params.futilityBase + params.futilityMargin * depth <= alpha)
+        {
+            continue;
+        }
 
-    for (int i = 0; i < moveCount; ++i)
-    {
-        int moveFrom = moves[i].from;
-        int moveTo = moves[i].to;
+        if (!rootNode && i > 0 && depth <= SEE_PRUNE_DEPTH && !inCheck && bestScore > -SCORE_MATE_IN_MAX_PLY)
+        {
+            int threshold = quiet ? -SEE_QUIET_MARGIN * depth : -SEE_CAPTURE_MARGIN * depth * depth;
+            if (board.staticExchange(moves[i]) < threshold)
+                continue;
+        }
 
-        board.movePiece(moveFrom, moveTo); // Make this return last move
+        // Extensions are only granted while the line is shorter than twice the iteration depth,
+        // which bounds how far they can stretch it
+        bool canExtend = !rootNode && ply < 2 * rootDepth;
+        int extension = 0;
+
+        // Singular extension: when every other move fails clearly below the TT move's score in a
+        // reduced search, the TT move is forced and searched one ply deeper. If even that
+        // search fails high at or above beta, several moves refute the node (multi-cut).
+        if (canExtend && !excluded && depth >= params.singularDepth && moves[i] == ttMove &&
+            entry.flag != UPPERBOUND && entry.depth >= depth - 3 && !isMateScore(scoreFromTT(entry.evaluation, ply)))
+        {
+            int singularBeta = scoreFromTT(entry.evaluation, ply) - params.singularMargin * depth;
+
+            excludedMoves[ply] = ttMove;
+            int singularScore = negamax<NonPV>(board, (depth - 1) / 2, singularBeta - 1, singularBeta, evaluate, ply, cutNode).first;
+            excludedMoves[ply] = NULL_MOVE;
+
+            if (aborted) [[unlikely]]
+            {
+                return {0, NULL_MOVE};
+            }
+
+            if (singularScore < singularBeta)
+                extension = 1;
+            else if (!pvNode && singularBeta >= beta)
+                return {singularBeta, NULL_MOVE};
+        }
+
+        plyMoves[ply] = moves[i];
+        plyPieces[ply] = board.pieceToIndex(board.getPieceAtSquare(moveFrom));
+        onPv[ply + 1] = onPv[ply] && ply < static_cast<int>(previousPv.size()) && moves[i] == previousPv[ply];
+
+        board.movePiece(moveFrom, moveTo);
         lastMove = board.getLastMove();
+        plyCaptures[ply] = lastMove.capturedPiece != ' ' || lastMove.wasEnPassant;
+
+        bool givesCheck = board.isKingInCheck(board.whiteToMove);
 
-        int newDepth = depth - 1;
+        if (canExtend && extension == 0)
+        {
+            // Check extension: the reply is forced, so the check costs no depth
+            if (givesCheck)
+                extension = 1;
+            // Recapture extension: restoring the material balance on the PV is not a new idea
+            else if (pvNode && params.recaptureExtension && plyCaptures[ply] && plyCaptures[ply - 1] &&
+                     moveTo == plyMoves[ply - 1].to)
+                extension = 1;
+        }
+        extensions += extension;
+
+        int newDepth = depth - 1 + extension;
         int childScore;
 
-        if (depth >= 6 && i >= 7)
+        if (movesSearched++ == 0)
+        {
+            childScore = -negamax<pvNode ? PV : NonPV>(board, newDepth, -beta, -alpha, evaluate, ply + 1, !pvNode && !cutNode).first;
+        }
+        else
         {
-            // Reduced depth search
-            int reducedDepth = newDepth - 1;
-            childScore = minimax(board, reducedDepth, !maximizingPlayer, alpha, beta, evaluate).first;
+            int reduction = 0;
+            if (quiet && depth >= LMR_MIN_DEPTH && !inCheck)
+            {
+                reduction = lateMoveReduction(depth, i);
+
+                bool refutation = scores[i] >= COUNTER_MOVE_SCORE && scores[i] <= KILLER_SCORE;
+
+                reduction -= pvNode;
+                reduction -= givesCheck;
+                reduction -= refutation;
+                reduction += cutNode;
+                if (!refutation)
+                {
+                    reduction -= std::clamp(scores[i] / LMR_HISTORY_DIVISOR, -2, 2);
+                }
+
+                reduction = std::clamp(reduction, 0, newDepth - 1);
+            }
+
+            // Zero-window search, reduced for late quiet moves; a reduced fail-high is verified at full depth
+            childScore = -negamax<NonPV>(board, newDepth - reduction, -alpha - 1, -alpha, evaluate, ply + 1, true).first;
 
-            if (maximizingPlayer && childScore > alpha && childScore < beta)
+            SEARCH_STAT(if (reduction > 0) stats.reducedSearch(childScore > alpha));
+            if (reduction > 0 && childScore > alpha)
             {
-                childScore = minimax(board, newDepth, !maximizingPlayer, alpha, beta, evaluate).first;
+                lmrResearches++;
+                childScore = -negamax<NonPV>(board, newDepth, -alpha - 1, -alpha, evaluate, ply + 1, !cutNode).first;
             }
-            else if (!maximizingPlayer && childScore < beta && childScore > alpha)
+            if (pvNode && childScore > alpha && childScore < beta)
             {
-                childScore = minimax(board, newDepth, !maximizingPlayer, alpha, beta, evaluate).first;
+                childScore = -negamax<PV>(board, newDepth, -beta, -alpha, evaluate, ply + 1, false).first;
             }
         }
-        else
+
+        board.undoMove(lastMove);
+
+        if (aborted) [[unlikely]]
         {
-            // Normal full depth search
-            childScore = minimax(board, newDepth, !maximizingPlayer, alpha, beta, evaluate).first;
+            return {0, NULL_MOVE};
         }
 
-        // nodesExplored++;
+        if (childScore > bestScore)
+        {
+            bestScore = childScore;
+            bestMove = {moveFrom, moveTo};
 
-        board.undoMove(lastMove);
+            if (childScore > alpha)
+            {
+                alpha = childScore;
+                if (pvNode)
+                {
+                    updatePv(ply, bestMove);
+                }
+                if (alpha >= beta) [[unlikely]]
+                {
+                    betaCutoffs++;
+                    firstMoveCutoffs += movesSearched == 1;
+                    SEARCH_STAT(stats.cutoff(movesSearched - 1));
+                    if (quiet)
+                    {
+                        updateQuietStats(board, bestMove, quietsTried, quietCount, depth, ply);
+                    }
+                    break; //  Beta cutoff
+                }
+            }
+        }
 
-        if (maximizingPlayer)
+        if (quiet)
         {
-            if (childScore > bestScore)
-            {
+            quietsTried[quietCount++] = moves[i];
+        }
+    }
 
-                bestScore = childScore;
-                bestMove = {moveFrom, moveTo};
-            }
-            alpha = std::max(alpha, bestScore);
+    // A singular search is not stored; if every other move was pruned it simply fails low
+    if (excluded)
+    {
+        return {bestScore == NEG_INF ? alpha : bestScore, bestMove};
+    }
+
+    // A MultiPV line below the first must not replace the root's hash move
+    if (rootNode && !rootExcluded.empty())
+    {
+        return {bestScore, bestMove};
+    }
+
+    board.storeTransposition(positionHash, depth, scoreToTT(bestScore, ply), scoreToTT(originalAlpha, ply), scoreToTT(beta, ply), bestMove.from, bestMove.to);
+
+    return {bestScore, bestMove};
+}
+
+/**
+ * @brief Scores moves for ordering.
+ *
+ * The hash move comes first, then captures and promotions that do not lose material in a
+ * static exchange, by most valuable victim and least valuable attacker, then the two killers of this ply and the countermove to the previous
+ * move, then the remaining quiet moves by butterfly plus one- and two-ply continuation history.
+ * Losing captures go last.
+ */
+void Node::scoreMoves(Board &board, const Move moves[], int scores[], int moveCount, Move ttMove, int ply)
+{
+    int colour = board.whiteToMove ? 0 : 1;
+    PieceToHistory *followUp = continuationTable(ply, 1);
+    PieceToHistory *secondFollowUp = continuationTable(ply, 2);
+    Move counterMove = followUp ? counterMoves[plyPieces[ply - 1]][plyMoves[ply - 1].to] : NULL_MOVE;
+
+    for (int i = 0; i < moveCount; ++i)
+    {
+        const Move &move = moves[i];
+        char attacker = board.getPieceAtSquare(move.from);
+        char victim = board.getPieceAtSquare(move.to);
+
+        if (onPv[ply] && ply < static_cast<int>(previousPv.size()) && move == previousPv[ply])
+        {
+            scores[i] = PV_MOVE_SCORE;
+        }
+        else if (move == ttMove)
+        {
+            scores[i] = TT_MOVE_SCORE;
+        }
+        else if (isTactical(board, move))
+        {
+            int gain = victim == ' ' ? (move.to < 8 || move.to >= 56 ? 800 : 100) : board.pieceValue(victim);
+            int mvvLva = gain * 16 - board.pieceValue(attacker) / 100;
+            scores[i] = (board.staticExchange(move) >= 0 ? CAPTURE_SCORE : BAD_CAPTURE_SCORE) + mvvLva;
+        }
+        else if (move == killers[ply][0])
+        {
+            scores[i] = KILLER_SCORE;
+        }
+        else if (move == killers[ply][1])
+        {
+            scores[i] = KILLER_SCORE - 1;
+        }
+        else if (move == counterMove)
+        {
+            scores[i] = COUNTER_MOVE_SCORE;
         }
         else
         {
-            if (childScore < bestScore)
-            {
-                bestScore = childScore;
-                bestMove = {moveFrom, moveTo};
-            }
-            beta = std::min(beta, bestScore);
+            int piece = board.pieceToIndex(attacker);
+            scores[i] = history[colour][move.from][move.to];
+            if (followUp)
+                scores[i] += (*followUp)[piece][move.to];
+            if (secondFollowUp)
+                scores[i] += (*secondFollowUp)[piece][move.to];
         }
+    }
+}
+
+/**
+ * @brief Applies a gravity update: the entry moves towards +-HISTORY_MAX by bonus, more slowly the closer it is.
+ */
+template <typename T>
+static void updateHistoryEntry(T &entry, int bonus)
+{
+    entry += bonus - entry * std::abs(bonus) / HISTORY_MAX;
+}
+
+PieceToHistory *Node::continuationTable(int ply, int plies)
+{
+    if (ply < plies || plyPieces[ply - plies] < 0)
+        return nullptr;
+    return &continuationHistory[plies - 1][plyPieces[ply - plies] * 64 + plyMoves[ply - plies].to];
+}
+
+/**
+ * Called with the board back at the node, so every tried move's piece is still on its from square.
+ */
+void Node::updateQuietStats(Board &board, Move move, const Move quietsTried[], int quietCount, int depth, int ply)
+{
+    if (killers[ply][0] != move)
+    {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    int colour = board.whiteToMove ? 0 : 1;
+    int bonus = std::min(depth * depth * 16, 1600);
+    PieceToHistory *followUp = continuationTable(ply, 1);
+    PieceToHistory *secondFollowUp = continuationTable(ply, 2);
+
+    if (followUp)
+    {
+        counterMoves[plyPieces[ply - 1]][plyMoves[ply - 1].to] = move;
+    }
+
+    auto update = [&](Move quiet, int amount)
+    {
+        int piece = board.pieceToIndex(board.getPieceAtSquare(quiet.from));
+        updateHistoryEntry(history[colour][quiet.from][quiet.to], amount);
+        if (followUp)
+            updateHistoryEntry((*followUp)[piece][quiet.to], amount);
+        if (secondFollowUp)
+            updateHistoryEntry((*secondFollowUp)[piece][quiet.to], amount);
+    };
+
+    update(move, bonus);
+    for (int i = 0; i < quietCount; ++i)
+    {
+        update(quietsTried[i], -bonus);
+    }
+}
+
+template std::pair<int, Move> Node::negamax<Root>(Board &, int, int, int, Evaluation &, int, bool);
+template std::pair<int, Move> Node::negamax<PV>(Board &, int, int, int, Evaluation &, int, bool);
+template std::pair<int, Move> Node::negamax<NonPV>(Board &, int, int, int, Evaluation &, int, bool);
+
+/**
+ * @brief Quiescence search: resolves captures and promotions below the horizon.
+ *
+ * The side to move may stand pat on the static evaluation or try a capture. Captures are
+ * searched most valuable victim first, and a capture that cannot bring the score back to
+ * alpha even with DELTA_MARGIN on top of the captured piece is skipped (delta pruning).
+ * Captures that lose material in a static exchange are skipped as well. A side in check
+ * has no stand-pat option and searches every evasion instead.
+ *
+ * @param board Current board state.
+ * @param alpha Lower bound of the window.
+ * @param beta Upper bound of the window.
+ * @param evaluate Reference to the evaluation function.
+ * @param ply Distance from the root.
+ * @return Score of the position once it is quiet, from the side to move's point of view.
+ */
+int Node::quiescence(Board &board, int alpha, int beta, Evaluation &evaluate, int ply)
+{
+    nodesExplored++;
+    quiescenceNodes++;
+    pvLength[ply] = ply;
+    selDepth = std::max(selDepth, ply);
+
+    checkStop();
+    if (aborted) [[unlikely]]
+    {
+        return 0;
+    }
+
+    board.moveCount = 0;
 
-        if (beta <= alpha) [[unlikely]]
-            break; //  Alpha-Beta Pruning
+    board.computeZobristHash();
+    uint64_t positionHash = board.getZobristHash();
+
+    TTEntry entry;
+    if (board.probeTranspositionTable(positionHash, 0, scoreToTT(alpha, ply), scoreToTT(beta, ply), entry))
+    {
+        return scoreFromTT(entry.evaluation, ply);
     }
 
-    if (bestMove != NULL_MOVE) [[likely]]
+    bool white = board.whiteToMove;
+
+    // Checked before the evasions too: a line of checks must not run past the ply tables
+    if (ply >= MAX_PLY) [[unlikely]]
+        return white ? evaluate.evaluatePosition() : -evaluate.evaluatePosition();
+
+    bool inCheck = board.isKingInCheck(white);
+
+    Move moves[256];
+    int moveCount;
+    int standPat = 0;
+    int bestScore;
+
+    if (inCheck)
     {
-        // Check if bestMove is already in the previousBestMoves array
-        if (std::find(std::begin(previousBestMoves),
-                      std::end(previousBestMoves),
-                      bestMove) == std::end(previousBestMoves))
+        moveCount = board.getAllLegalMovesAsArray(moves, white).from;
+        if (moveCount == 0)
         {
-            std::move_backward(std::begin(previousBestMoves),
-                               std::end(previousBestMoves) - 1,
-                               std::end(previousBestMoves));
-            previousBestMoves[0] = bestMove;
+            return matedIn(ply);
         }
-        killerMoves[depth] = bestMove;
-    }else [[unlikely]]
+        bestScore = NEG_INF;
+    }
+    else
     {
-        bestMove = moves[0];
-        std::cout << "Null move returned" << std::endl;
+        standPat = white ? evaluate.evaluatePosition() : -evaluate.evaluatePosition();
+        bestScore = standPat;
+
+        if (standPat >= beta)
+            return standPat;
+        alpha = std::max(alpha, standPat);
+
+        moveCount = board.getCaptureMovesAsArray(moves, white);
     }
 
-    board.storeTransposition(positionHash, depth, bestScore, alpha, beta, bestMove.from, bestMove.to);
+    // Material each move wins: the captured piece (a pawn for en passant) plus the queen for a promotion
+    int gains[256];
+    int order[256];
+    for (int i = 0; i < moveCount; ++i)
+    {
+        char attacker = board.getPieceAtSquare(moves[i].from);
+        char victim = board.getPieceAtSquare(moves[i].to);
+        bool promotion = std::tolower(attacker) == 'p' && (moves[i].to < 8 || moves[i].to >= 56);
+        bool enPassant = std::tolower(attacker) == 'p' && victim == ' ' && (moves[i].from % 8) != (moves[i].to % 8);
 
-    return {bestScore, bestMove};
-}
\ No newline at end of file
+        gains[i] = (enPassant ? 100 : board.pieceValue(victim)) + (promotion ? 800 : 0);
+        order[i] = gains[i] * 16 - board.pieceValue(attacker) / 100;
+    }
+
+    for (int i = 0; i < moveCount; ++i)
+    {
+        // Selection sort step: bring the most valuable victim, least valuable attacker forward
+        int best = i;
+        for (int j = i + 1; j < moveCount; ++j)
+        {
+            if (order[j] > order[best])
+                best = j;
+        }
+        std::swap(moves[i], moves[best]);
+        std::swap(gains[i], gains[best]);
+        std::swap(order[i], order[best]);
+
+        if (!inCheck && gains[i] < 800 && standPat + gains[i] + DELTA_MARGIN <= alpha)
+        {
+            continue;
+        }
+
+        // A capture that loses material in the exchange cannot make the position quiet in our favour
+        if (!inCheck && board.staticExchange(moves[i]) < 0)
+        {
+            continue;
+        }
+
+        board.movePiece(moves[i].from, moves[i].to);
+        LastMove lastMove = board.getLastMove();
+
+        int childScore = -quiescence(board, -beta, -alpha, evaluate, ply + 1);
+
+        board.undoMove(lastMove);
+
+        if (aborted) [[unlikely]]
+        {
+            return 0;
+        }
+
+        if (childScore > bestScore)
+        {
+            bestScore = childScore;
+            if (childScore > alpha)
+            {
+                alpha = childScore;
+                if (alpha >= beta)
+                    break;
+            }
+        }
+    }
+
+    return bestScore;
+}
@@ -10,14 +10,63 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <atomic>
+#include <chrono>
+#include <array>
 #include "Board.h"
 #include "Evaluation.h"
+#include "Score.h"
+#include "TimeManager.h"
+#include "SearchStats.h"
+
+/**
+ * @brief Outcome of a search: deepest completed iteration, its score and move, and the nodes spent.
+ */
+struct SearchResult
+{
+    int depth = 0;
+    int score = 0;
+    Move move = {-1, -1};
+    uint64_t nodes = 0;
+    uint64_t quiescenceNodes = 0;
+    double branchingFactor = 0.0;
+    uint64_t betaCutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;
+    Move ponder = {-1, -1};
+    uint64_t pawnTableProbes = 0;
+    uint64_t pawnTableHits = 0;
+};
+
+/**
+ * @brief Best move, score (side to move's point of view) and principal variation of one MultiPV line.
+ */
+struct RootLine
+{
+    Move move;
+    int score;
+    std::vector<Move> pv;
+};
+
+/**
+ * @brief Quiet move history indexed by [moved piece][target square], pieces as in Board::pieceToIndex.
+ */
+using PieceToHistory = std::array<std::array<int16_t, 64>, 12>;
+
+/**
+ * @brief Kind of node in the search tree. Only Root and PV nodes are searched with an open window.
+ */
+enum NodeType
+{
+    Root,
+    PV,
+    NonPV
+};
 
 /**
  * @class Node
  * @brief Represents a root node in the game tree used for minimax search in chess.
  *
- * This class implements key functions for iterative deepening and minimax 
+ * This class implements key functions for iterative deepening and negamax
  * search with alpha-beta pruning, storing best moves and move-ordering heuristics.
  */
 class Node
@@ -28,63 +77,122 @@ public:
      *
      * Initializes the move variables to invalid positions (-10, -1),
      * score to 0, and sets gameOver to false.
-     * Also initializes previous best moves with invalid values (-1, -1).
+     * Also initializes the killer moves with invalid values (-1, -1).
      */
     Node()
         : from(-10), to(-1), score(0), gameOver(false)
     {
-       
-        std::fill(std::begin(previousBestMoves), std::end(previousBestMoves), Move{-1,-1});
-
+        std::fill(&killers[0][0], &killers[0][0] + (MAX_PLY + 1) * 2, Move{-1, -1});
+        std::fill(&counterMoves[0][0], &counterMoves[0][0] + 12 * 64, Move{-1, -1});
+        std::fill(excludedMoves, excludedMoves + MAX_PLY + 1, Move{-1, -1});
+        continuationHistory[0].resize(12 * 64);
+        continuationHistory[1].resize(12 * 64);
+        pvTable.resize(MAX_PLY + 2);
     }
 
+    /**
+     * @brief Resets the move-ordering heuristics so a reused Node searches like a fresh one.
+     */
+    void newSearch();
+
+    /**
+     * @brief Clears all move-ordering heuristics, for a new game or a reproducible search.
+     */
+    void newGame();
+
     /**
      * @brief Implements Iterative Deepening Depth-First Search (IDDFS) with minimax.
      * 
-     * This function iteratively calls the minimax function up to a given depth.
+     * This function iteratively calls the negamax search up to a given depth.
      * It ensures deeper searches are guided by previous best moves, improving efficiency.
      *
      * @param board Shared pointer to the current board state.
      * @param maxDepth Maximum search depth.
-     * @param maximizingPlayer True if the current player is maximizing, false if minimizing.
+     * @param maximizingPlayer True if white is to move; must match board->whiteToMove.
      * @param evaluate Reference to the evaluation function.
-     * @return The best move as a pair: (evaluation score, (from, to)).
+     * @return The best move as a pair: (evaluation score from white's point of view, (from, to)).
      */
     std::pair<int, Move> iterativeDeepening(std::shared_ptr<Board> board, int maxDepth, bool maximizingPlayer, Evaluation &evaluate);
 
     /**
-     * @brief Minimax algorithm with alpha-beta pruning and principal variation search (PV).
+     * @brief Root search of one iteration with an aspiration window around previousScore.
+     */
+    std::pair<int, Move> aspirationSearch(Board &board, int depth, int previousScore, Evaluation &evaluate, int &researches);
+
+    /**
+     * @brief Whether a root move is searched, given searchMoves and the MultiPV lines already found.
+     */
+    bool isSearchedRootMove(Move move) const;
+
+    /**
+     * @brief Principal variation of the last root search, or just best if it has none.
+     */
+    std::vector<Move> rootPv(Move best) const;
+
+    /**
+     * @brief Sets the principal variation at ply to move followed by the one at ply + 1.
+     */
+    void updatePv(int ply, Move move);
+
+    /**
+     * @brief Prints the MultiPV lines of the last completed iteration as UCI info lines.
+     */
+    void printRootLines(Board &board, int depth);
+
+    /**
+     * @brief Negamax search with alpha-beta pruning and principal variation search.
      *
-     * This function evaluates possible moves recursively, using alpha-beta pruning 
-     * to eliminate unnecessary branches, improving search efficiency.
+     * Scores are from the side to move's point of view. Non-first moves are searched with
+     * a zero window and re-searched with the full window when they fail high at a PV node.
      *
-     * @param board Shared pointer to the current board state.
+     * @tparam nodeType Root, PV or NonPV; PV-only work compiles out of NonPV nodes.
+     * @param board Current board state; the side to move is board.whiteToMove.
      * @param depth Remaining search depth.
-     * @param maximizingPlayer True if maximizing, false if minimizing.
-     * @param alpha Alpha pruning value (best max score found).
-     * @param beta Beta pruning value (best min score found).
+     * @param alpha Lower bound of the window.
+     * @param beta Upper bound of the window.
      * @param evaluate Reference to the evaluation function.
-     * @param isPV True if this is a principal variation search.
-     * @param pvMove Move in the principal variation to prioritize.
-     * @return The best move as a pair: (evaluation score, (from, to)).
+     * @param ply Distance from the root.
+     * @param cutNode True for zero-window nodes expected to fail high; they are reduced more.
+     * @return The best move as a pair: (score, (from, to)).
      */
-    std::pair<int, Move> minimax(std::shared_ptr<Board> board, int depth, bool maximizingPlayer, int alpha, int beta, Evaluation &evaluate, bool isPV, std::pair<int, int> pvMove);
+    template <NodeType nodeType>
+    std::pair<int, Move> negamax(Board &board, int depth, int alpha, int beta, Evaluation &evaluate, int ply, bool cutNode);
 
-      /**
-     * @brief Standard minimax function with alpha-beta pruning.
+    /**
+     * @brief Searches captures and promotions until the position is quiet.
      *
-     * This function searches for the best move up to a given depth, pruning
-     * unpromising branches to improve performance.
+     * Called instead of the static evaluation when negamax reaches depth 0.
      *
-     * @param board Shared pointer to the current board state.
-     * @param depth Remaining search depth.
-     * @param maximizingPlayer True if maximizing, false if minimizing.
-     * @param alpha Alpha pruning value.
-     * @param beta Beta pruning value.
+     * @param board Current board state.
+     * @param alpha Lower bound of the window.
+     * @param beta Upper bound of the window.
      * @param evaluate Reference to the evaluation function.
-     * @return The best move as a pair: (evaluation score, (from, to)).
+     * @param ply Distance from the root.
+     * @return Score of the quiet position from the side to move's point of view.
+     */
+    int quiescence(Board &board, int alpha, int beta, Evaluation &evaluate, int ply);
+
+    /**
+     * @brief Sets aborted once stopFlag is raised or the time manager's hard limit has passed.
      */
-    std::pair<int, Move> minimax(Board& board, int depth, bool maximizingPlayer, int alpha, int beta, Evaluation &evaluate);
+    void checkStop();
+
+    /**
+     * @brief Gives every move an ordering score: PV move, hash move, captures by MVV-LVA, killers, then quiets by history.
+     */
+    void scoreMoves(Board &board, const Move moves[], int scores[], int moveCount, Move ttMove, int ply);
+
+    /**
+     * @brief Updates killers, countermove and the history tables after a quiet move caused a beta cutoff.
+     *
+     * @param quietsTried Quiet moves searched before the cutoff move; their history is lowered.
+     */
+    void updateQuietStats(Board &board, Move move, const Move quietsTried[], int quietCount, int depth, int ply);
+
+    /**
+     * @brief Continuation history table following the move made plies back from ply, or nullptr if there is none.
+     */
+    PieceToHistory *continuationTable(int ply, int plies);
 
     /** Move origin square index. Initialized to -10 (invalid). */
     int from = -10; 
@@ -95,19 +203,128 @@ public:
     /** Score of the current node, used in evaluation functions. */
     int score = 0;
 
-    /** Number of nodes explored in the search. */
-    int nodesExplored = 0;
+    /** Number of nodes explored in the search: every negamax and quiescence call that is not cut off by depth. */
+    uint64_t nodesExplored = 0;
+
+    /** Number of those nodes visited by the quiescence search. */
+    uint64_t quiescenceNodes = 0;
+
+    /** Aspiration window re-searches in the last iterativeDeepening call. */
+    int aspirationResearches = 0;
+
+    /** Beta cutoffs in the main search, and how many of them the first move produced. */
+    uint64_t betaCutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;
+
+    /** Reduced searches that failed high and were repeated at full depth. */
+    uint64_t lmrResearches = 0;
+
+    /** Nodes of the last completed iteration divided by nodes of the one before it. */
+    double branchingFactor = 0.0;
+
+    /** Set while the child of a null move made at that ply is searched, to forbid two in a row. */
+    bool nullMoveAt[MAX_PLY + 1] = {};
+
+    /** Null moves are not tried before this ply; raised during a null-move verification search. */
+    int nullMoveMinPly = 0;
 
     /** Indicates if the game has reached a terminal state (checkmate, draw). */
     bool gameOver = false;
 
-    /** Stores previous best moves for move ordering optimizations (used in iterative deepening). */
-    Move previousBestMoves[7];
+    /** Two quiet moves per ply that last caused a beta cutoff there, most recent first. */
+    Move killers[MAX_PLY + 1][2];
+
+    /**
+     * Butterfly history [colour][from][to]: how well a quiet move has done, raised when it
+     * causes a cutoff and lowered when it was searched before another quiet that did.
+     */
+    int history[2][64][64] = {};
+
+    /** The quiet move that last refuted a move, indexed by the refuted move's [piece][to]. */
+    Move counterMoves[12][64];
+
+    /**
+     * One- and two-ply continuation history. Entry [k][piece * 64 + to] scores quiet moves
+     * made k + 1 plies after a move of that piece to that square. Heap allocated (1.2 MB each)
+     * because Nodes are often created on the stack.
+     */
+    std::vector<PieceToHistory> continuationHistory[2];
+
+    /** Move made at each ply of the current line and the moved piece's index, -1 for a null move. */
+    Move plyMoves[MAX_PLY + 1];
+    int plyPieces[MAX_PLY + 1] = {};
+
+    /** Static evaluation at each ply of the current line, NEG_INF when in check there. */
+    int plyEvals[MAX_PLY + 1] = {};
+
+    /** Whether the move made at each ply of the current line captured something. */
+    bool plyCaptures[MAX_PLY + 1] = {};
+
+    /** Move skipped at each ply during a singular extension search there, {-1, -1} otherwise. */
+    Move excludedMoves[MAX_PLY + 1];
+
+    /**
+     * Triangular PV table: row ply holds the best line found from ply, in entries
+     * [ply, pvLength[ply]). Heap allocated for the same reason as continuationHistory.
+     */
+    std::vector<std::array<Move, MAX_PLY + 2>> pvTable;
+    int pvLength[MAX_PLY + 2] = {};
+
+    /** Principal variation of the last completed iteration; its moves are searched first. */
+    std::vector<Move> previousPv;
+
+    /** Whether every move leading to each ply of the current line follows previousPv. */
+    bool onPv[MAX_PLY + 2] = {};
+
+    /** Deepest ply reached in the current iteration, quiescence included. */
+    int selDepth = 0;
+
+    /** When the current iterativeDeepening call started, for the info lines. */
+    std::chrono::steady_clock::time_point searchStart;
+
+    /** Number of best root moves to search and report per iteration (UCI MultiPV). */
+    int multiPV = 1;
+
+    /** Lines of the last completed iteration, best first; rootLines[0] is the best move. */
+    std::vector<RootLine> rootLines;
+
+    /** Stop once this many nodes were searched (0: no limit); checked at every node, so a single thread stops deterministically. */
+    uint64_t nodeLimit = 0;
+
+    /** When not empty, only these root moves are searched (UCI go searchmoves). */
+    std::vector<Move> searchMoves;
+
+    /** Root moves skipped while searching the further MultiPV lines of an iteration. */
+    std::vector<Move> rootExcluded;
+
+    /** Depth of the current iteration; bounds how far extensions may stretch a line. */
+    int rootDepth = 0;
+
+    /** Extensions granted in the last iterativeDeepening call. */
+    uint64_t extensions = 0;
+
+    /** Optional flag set by another thread to abort the search. Polled every 2048 nodes once depth 1 is done. */
+    std::atomic<bool> *stopFlag = nullptr;
+
+    /** Limits of a timed search, or nullptr to search to maxDepth. Only the main thread has one. */
+    const TimeManager *timeManager = nullptr;
+
+    /** Set when the search was aborted through stopFlag or the time limit; the unfinished iteration is discarded. */
+    bool aborted = false;
+
+    /** Deepest iteration that completed without being aborted. */
+    int completedDepth = 0;
+
+    /** Prints per-iteration progress. Off for helper threads so only the main thread reports. */
+    bool verbose = true;
 
-    /** Stores killer moves (strong moves from previous searches) to improve move ordering. */
-    std::unordered_map<int, Move> killerMoves;
+    /** When the first iteration's report was printed; used to measure go latency. */
+    std::chrono::steady_clock::time_point firstReportTime;
 
-    
+#ifdef BOTFISH_STATS
+    /** Detailed counters of the last iterativeDeepening call; see SearchStats.h. */
+    SearchStats stats;
+#endif
 
 };
 
@@ -0,0 +1,111 @@
+#ifndef PAWN_MASKS_H
+#define PAWN_MASKS_H
+
+#include <cstdint>
+
+// Square 0 is a8, so white pawns advance towards lower square indices. Colour index 0 is
+// white and 1 is black, as in PawnEntry::halfOpenFiles.
+
+constexpr uint64_t FILE_A = 0x0101010101010101ULL;
+constexpr uint64_t FILE_H = FILE_A << 7;
+
+constexpr uint64_t makeFileMask(int file)
+{
+    return FILE_A << file;
+}
+
+constexpr uint64_t makeAdjacentFileMask(int file)
+{
+    return (file > 0 ? makeFileMask(file - 1) : 0) | (file < 7 ? makeFileMask(file + 1) : 0);
+}
+
+// Every square on the rows in front of square, seen from the given colour
+constexpr uint64_t makeRowsAhead(int square, int colour)
+{
+    int row = square / 8;
+    if (colour == 0)
+        return (1ULL << (row * 8)) - 1;
+    return row < 7 ? ~((1ULL << ((row + 1) * 8)) - 1) : 0;
+}
+
+struct PawnMaskTables
+{
+    uint64_t file[8] = {};
+    uint64_t adjacentFiles[8] = {};
+
+    // Squares in front of a pawn on its own file
+    uint64_t forwardSpan[2][64] = {};
+
+    // Squares in front of a pawn on its own and the adjacent files; no enemy pawn there means passed
+    uint64_t passedPawn[2][64] = {};
+};
+
+constexpr PawnMaskTables makePawnMaskTables()
+{
+    PawnMaskTables masks;
+    for (int file = 0; file < 8; file++)
+    {
+        masks.file[file] = makeFileMask(file);
+        masks.adjacentFiles[file] = makeAdjacentFileMask(file);
+    }
+    for (int colour = 0; colour < 2; colour++)
+    {
+        for (int square = 0; square < 64; square++)
+        {
+            uint64_t ahead = makeRowsAhead(square, colour);
+            masks.forwardSpan[colour][square] = ahead & masks.file[square % 8];
+            masks.passedPawn[colour][square] = ahead & (masks.file[square % 8] | masks.adjacentFiles[square % 8]);
+        }
+    }
+    return masks;
+}
+
+inline constexpr PawnMaskTables PAWN_MASKS = makePawnMaskTables();
+
+// Set-wise helpers working on every pawn of a bitboard at once
+
+// Squares one step towards the a-file and the h-file; nothing wraps around the board
+constexpr uint64_t shiftWest(uint64_t bitboard) { return (bitboard & ~FILE_A) >> 1; }
+constexpr uint64_t shiftEast(uint64_t bitboard) { return (bitboard & ~FILE_H) << 1; }
+
+// The bitboard smeared towards square 0 (rank 8) or square 63 (rank 1), itself included
+constexpr uint64_t northFill(uint64_t bitboard)
+{
+    bitboard |= bitboard >> 8;
+    bitboard |= bitboard >> 16;
+    bitboard |= bitboard >> 32;
+    return bitboard;
+}
+
+constexpr uint64_t southFill(uint64_t bitboard)
+{
+    bitboard |= bitboard << 8;
+    bitboard |= bitboard << 16;
+    bitboard |= bitboard << 32;
+    return bitboard;
+}
+
+// Every file holding at least one of the pieces
+constexpr uint64_t fileFill(uint64_t bitboard)
+{
+    return northFill(bitboard) | southFill(bitboard);
+}
+
+// Squares in front of the pawns of the given colour on their files, and behind them
+constexpr uint64_t frontSpans(uint64_t pawns, bool white)
+{
+    return white ? northFill(pawns) >> 8 : southFill(pawns) << 8;
+}
+
+constexpr uint64_t rearSpans(uint64_t pawns, bool white)
+{
+    return frontSpans(pawns, !white);
+}
+
+// Squares attacked by the pawns of the given colour
+constexpr uint64_t pawnAttacks(uint64_t pawns, bool white)
+{
+    return white ? shiftWest(pawns >> 8) | shiftEast(pawns >> 8) : shiftWest(pawns << 8) | shiftEast(pawns << 8);
+}
+
+#endif // PAWN_MASKS_H
@@ -0,0 +1,35 @@
+#include "PawnTable.h"
+
+// Key of an unused slot. A real pawn key equal to it would only cost a wrong cache hit, the
+// same as any other key collision.
+constexpr uint64_t EMPTY_KEY = ~0ULL;
+
+PawnTable::PawnTable() : entries(std::make_unique<PawnEntry[]>(PAWN_TABLE_SIZE))
+{
+    clear();
+}
+
+PawnEntry &PawnTable::probe(uint64_t key, bool &hit)
+{
+    PawnEntry &entry = entries[key & (PAWN_TABLE_SIZE - 1)];
+    probes++;
+    hit = entry.key == key;
+    hits += hit;
+    return entry;
+}
+
+void PawnTable::clear()
+{
+    for (size_t i = 0; i < PAWN_TABLE_SIZE; i++)
+    {
+        entries[i] = {};
+        entries[i].key = EMPTY_KEY;
+    }
+    resetStats();
+}
+
+void PawnTable::resetStats()
+{
+    probes = 0;
+    hits = 0;
+}
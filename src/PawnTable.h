@@ -0,0 +1,71 @@
+#ifndef PAWN_TABLE_H
+#define PAWN_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Number of entries; a power of two so the key can be masked into an index
+constexpr size_t PAWN_TABLE_SIZE = 1 << 14;
+
+/**
+ * @brief Everything the evaluation derives from the pawns alone, for one pawn structure.
+ *
+ * File masks hold every square of the files they contain, so a piece's square can be tested
+ * against them directly.
+ */
+struct PawnEntry
+{
+    uint64_t key;
+
+    // Passed, isolated, doubled and backward pawns, from white's point of view
+    int score;
+
+    // Files without any pawn
+    uint64_t openFiles;
+
+    // Files without a pawn of white [0] and of black [1]
+    uint64_t halfOpenFiles[2];
+
+    // Pawn shield in front of a white king on g1 and c1, and a black king on g8 and c8, from
+    // white's point of view
+    int whiteShield[2];
+    int blackShield[2];
+};
+
+/**
+ * @class PawnTable
+ * @brief Cache of pawn structure evaluations indexed by the board's pawn key.
+ *
+ * Pawn structures change far less often than positions, so nearly every evaluation finds its
+ * entry here. Each search thread owns its own table through its Evaluation, which keeps it
+ * free of locks.
+ */
+class PawnTable
+{
+public:
+    PawnTable();
+
+    /**
+     * @brief Returns the slot for a pawn key.
+     *
+     * @param key Pawn key of the position.
+     * @param hit Set to true if the slot already holds this structure; otherwise the caller
+     *            fills in the entry, key included.
+     */
+    PawnEntry &probe(uint64_t key, bool &hit);
+
+    void clear();
+
+    // Probes and hits since the last resetStats()
+    uint64_t getProbes() const { return probes; }
+    uint64_t getHits() const { return hits; }
+    void resetStats();
+
+private:
+    std::unique_ptr<PawnEntry[]> entries;
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+};
+
+#endif // PAWN_TABLE_H
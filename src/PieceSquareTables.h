@@ -0,0 +1,175 @@
+#ifndef PIECE_SQUARE_TABLES_H
+#define PIECE_SQUARE_TABLES_H
+
+// Piece-square tables from white's point of view, square 0 = a8. Black uses square ^ 63.
+constexpr int Pawns[64] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    10, 10, 20, 30, 30, 20, 10, 10,
+    5, 5, 10, 25, 25, 10, 5, 5,
+    0, -5, -5, 20, 20, -5, -5, 0,
+    5, -10, -10, 0, 0, -10, -10, 5,
+    5, 10, 10, -30, -30, 10, 10, 5,
+    0, 0, 0, 0, 0, 0, 0, 0};
+
+constexpr int PawnsEnd[64] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    80, 80, 80, 80, 80, 80, 80, 80,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    30, 30, 30, 30, 30, 30, 30, 30,
+    20, 20, 20, 20, 20, 20, 20, 20,
+    10, 10, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10,
+    0, 0, 0, 0, 0, 0, 0, 0};
+
+constexpr int KingSafety[64] = {
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -20, -30, -30, -40, -40, -30, -30, -20,
+    -10, -20, -20, -20, -20, -20, -20, -10,
+    20, 10, 0, 0, 0, 0, 10, 20,
+    40, 50, 10, 0, 0, 10, 50, 40};
+
+constexpr int KingEnd[64] = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -5, 0, 5, 5, 5, 5, 0, -5,
+    -10, -5, 20, 30, 30, 20, -5, -10,
+    -15, -10, 35, 45, 45, 35, -10, -15,
+    -20, -15, 30, 40, 40, 30, -15, -20,
+    -25, -20, 20, 25, 25, 20, -20, -25,
+    -30, -25, 0, 0, 0, 0, -25, -30,
+    -50, -30, -30, -30, -30, -30, -30, -50};
+
+constexpr int Knights[64] = {
+    -50, -40, -30, -30, -30, -30, -40, -50,
+    -40, -20, 0, 0, 0, 0, -20, -40,
+    -30, 0, 10, 15, 15, 10, 0, -30,
+    -30, 5, 15, 20, 20, 15, 5, -30,
+    -30, 0, 15, 20, 20, 15, 0, -30,
+    -30, 5, 20, 15, 15, 20, 5, -30,
+    -40, -20, 0, 0, 0, 0, -20, -40,
+    -50, -50, -30, -30, -30, -30, -50, -50};
+
+// Endgame knights: the rim matters less than in the middlegame, the centre a little more
+constexpr int KnightsEnd[64] = {
+    -50, -40, -30, -25, -25, -30, -40, -50,
+    -40, -20, -5, 0, 0, -5, -20, -40,
+    -30, -5, 10, 15, 15, 10, -5, -30,
+    -25, 0, 15, 20, 20, 15, 0, -25,
+    -25, 0, 15, 20, 20, 15, 0, -25,
+    -30, -5, 10, 15, 15, 10, -5, -30,
+    -40, -20, -5, 0, 0, -5, -20, -40,
+    -50, -40, -30, -25, -25, -30, -40, -50};
+
+constexpr int Bishops[64] = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10, 0, 0, 0, 0, 0, 0, -10,
+    -10, 0, 5, 10, 10, 5, 0, -10,
+    -10, 5, 5, 10, 10, 5, 5, -10,
+    -10, 0, 10, 10, 10, 10, 0, -10,
+    -10, 10, 10, 10, 10, 10, 10, -10,
+    -10, 5, 0, 0, 0, 0, 5, -10,
+    -20, -10, -10, -10, -10, -10, -10, -20};
+
+// Endgame bishops: long diagonals through the centre, no preference for either side
+constexpr int BishopsEnd[64] = {
+    -15, -10, -10, -5, -5, -10, -10, -15,
+    -10, 0, 0, 0, 0, 0, 0, -10,
+    -10, 0, 5, 5, 5, 5, 0, -10,
+    -5, 0, 5, 10, 10, 5, 0, -5,
+    -5, 0, 5, 10, 10, 5, 0, -5,
+    -10, 0, 5, 5, 5, 5, 0, -10,
+    -10, 0, 0, 0, 0, 0, 0, -10,
+    -15, -10, -10, -5, -5, -10, -10, -15};
+
+constexpr int Rooks[64] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    5, 10, 10, 10, 10, 10, 10, 5,
+    -5, 0, 0, 0, 0, 0, 0, -5,
+    -5, 0, 0, 0, 0, 0, 0, -5,
+    -5, 0, 0, 0, 0, 0, 0, -5,
+    -5, 0, 0, 0, 0, 0, 0, -5,
+    -5, 0, 0, 0, 0, 0, 0, -5,
+    -5, 0, 0, 10, 10, 0, 0, -5};
+
+// Endgame rooks: active on the seventh rank, otherwise nearly indifferent to the square
+constexpr int RooksEnd[64] = {
+    5, 5, 5, 5, 5, 5, 5, 5,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    -5, 0, 0, 0, 0, 0, 0, -5};
+
+// Endgame queens: centralised queens cover both wings
+constexpr int QueensEnd[64] = {
+    -20, -10, -10, -5, -5, -10, -10, -20,
+    -10, 0, 5, 5, 5, 5, 0, -10,
+    -10, 5, 10, 10, 10, 10, 5, -10,
+    -5, 5, 10, 15, 15, 10, 5, -5,
+    -5, 5, 10, 15, 15, 10, 5, -5,
+    -10, 5, 10, 10, 10, 10, 5, -10,
+    -10, 0, 5, 5, 5, 5, 0, -10,
+    -20, -10, -10, -5, -5, -10, -10, -20};
+
+constexpr int NoTable[64] = {};
+
+// Material by piece type in Board::pieceToIndex order: pawn, knight, bishop, rook, queen, king
+constexpr int PIECE_VALUES[6] = {100, 300, 320, 500, 900, 0};
+
+// Middlegame and endgame table of each piece type; queens have no middlegame table
+constexpr const int *MIDDLEGAME_TABLES[6] = {Pawns, Knights, Bishops, Rooks, NoTable, KingSafety};
+constexpr const int *ENDGAME_TABLES[6] = {PawnsEnd, KnightsEnd, BishopsEnd, RooksEnd, QueensEnd, KingEnd};
+
+// Contribution of each piece type to the game phase; pawns and kings do not count
+constexpr int PHASE_WEIGHTS[6] = {0, 1, 1, 2, 4, 0};
+
+// Phase of the starting position. More is possible after promotions and is treated as this.
+constexpr int MAX_PHASE = 24;
+
+/**
+ * @brief Blends a middlegame and an endgame score by phase, from the pure middlegame at
+ * MAX_PHASE to the pure endgame at 0.
+ */
+constexpr int taperedScore(int middlegame, int endgame, int phase)
+{
+    int weight = phase < MAX_PHASE ? phase : MAX_PHASE;
+    return (middlegame * weight + endgame * (MAX_PHASE - weight)) / MAX_PHASE;
+}
+
+/**
+ * @brief Material plus piece-square value of every piece on every square, indexed by
+ * Board::pieceToIndex and square. Black entries are negative, so summing over the board gives
+ * the score from white's point of view.
+ */
+struct PieceSquareScores
+{
+    int middlegame[12][64] = {};
+    int endgame[12][64] = {};
+    int phase[12] = {};
+};
+
+constexpr PieceSquareScores makePieceSquareScores()
+{
+    PieceSquareScores scores;
+    for (int type = 0; type < 6; type++)
+    {
+        scores.phase[type] = scores.phase[type + 6] = PHASE_WEIGHTS[type];
+        for (int square = 0; square < 64; square++)
+        {
+            scores.middlegame[type][square] = PIECE_VALUES[type] + MIDDLEGAME_TABLES[type][square];
+            scores.endgame[type][square] = PIECE_VALUES[type] + ENDGAME_TABLES[type][square];
+            scores.middlegame[type + 6][square] = -(PIECE_VALUES[type] + MIDDLEGAME_TABLES[type][square ^ 63]);
+            scores.endgame[type + 6][square] = -(PIECE_VALUES[type] + ENDGAME_TABLES[type][square ^ 63]);
+        }
+    }
+    return scores;
+}
+
+inline constexpr PieceSquareScores PIECE_SQUARE_SCORES = makePieceSquareScores();
+
+#endif // PIECE_SQUARE_TABLES_H
@@ -0,0 +1,53 @@
+#ifndef SCORE_H
+#define SCORE_H
+
+/**
+ * Search scores in centipawns from the side to move's point of view.
+ *
+ * All scores lie in [-SCORE_INFINITE, SCORE_INFINITE], small enough that windows and
+ * margins can be added to any of them without overflowing. Scores beyond
+ * +-SCORE_MATE_IN_MAX_PLY encode a forced mate: SCORE_MATE - n means the side to move mates
+ * n plies from the root, -SCORE_MATE + n that it gets mated. Static evaluations stay far
+ * below that range.
+ */
+using Score = int;
+
+constexpr int MAX_PLY = 128;
+
+constexpr Score SCORE_DRAW = 0;
+constexpr Score SCORE_MATE = 32000;
+constexpr Score SCORE_INFINITE = 32001;
+constexpr Score SCORE_MATE_IN_MAX_PLY = SCORE_MATE - MAX_PLY;
+
+// Score for mating the opponent ply plies from the root
+constexpr Score mateIn(int ply) { return SCORE_MATE - ply; }
+
+// Score for being mated ply plies from the root
+constexpr Score matedIn(int ply) { return -SCORE_MATE + ply; }
+
+constexpr bool isMateScore(Score score)
+{
+    return score >= SCORE_MATE_IN_MAX_PLY || score <= -SCORE_MATE_IN_MAX_PLY;
+}
+
+// Moves needed to deliver (positive) or suffer (negative) the mate encoded in score
+constexpr int mateInMoves(Score score)
+{
+    return score > 0 ? (SCORE_MATE - score + 1) / 2 : -(SCORE_MATE + score) / 2;
+}
+
+/**
+ * Mate scores are stored in the transposition table relative to the stored position
+ * instead of the root, so they stay correct when the position is reached at another ply.
+ */
+constexpr Score scoreToTT(Score score, int ply)
+{
+    return score >= SCORE_MATE_IN_MAX_PLY ? score + ply : score <= -SCORE_MATE_IN_MAX_PLY ? score - ply : score;
+}
+
+constexpr Score scoreFromTT(Score score, int ply)
+{
+    return score >= SCORE_MATE_IN_MAX_PLY ? score - ply : score <= -SCORE_MATE_IN_MAX_PLY ? score + ply : score;
+}
+
+#endif // SCORE_H
@@ -0,0 +1,47 @@
+#include "SearchParameters.h"
+
+#include <algorithm>
+
+SearchParameters searchParameters;
+
+const SearchParameterInfo searchParameterTable[] = {
+    {"ReverseFutilityDepth", &SearchParameters::reverseFutilityDepth, 0, 12},
+    {"ReverseFutilityMargin", &SearchParameters::reverseFutilityMargin, 20, 300},
+    {"FutilityDepth", &SearchParameters::futilityDepth, 0, 8},
+    {"FutilityBase", &SearchParameters::futilityBase, 0, 500},
+    {"FutilityMargin", &SearchParameters::futilityMargin, 20, 400},
+    {"RazorDepth", &SearchParameters::razorDepth, 0, 6},
+    {"RazorBase", &SearchParameters::razorBase, 0, 800},
+    {"RazorMargin", &SearchParameters::razorMargin, 0, 600},
+    {"LateMoveDepth", &SearchParameters::lateMoveDepth, 0, 12},
+    {"LateMoveBase", &SearchParameters::lateMoveBase, 1, 20},
+    {"HistoryPruningDepth", &SearchParameters::historyPruningDepth, 0, 8},
+    {"HistoryPruningMargin", &SearchParameters::historyPruningMargin, 0, 32768},
+    {"SingularDepth", &SearchParameters::singularDepth, 4, 20},
+    {"SingularMargin", &SearchParameters::singularMargin, 0, 10},
+    {"RecaptureExtension", &SearchParameters::recaptureExtension, 0, 1},
+    {nullptr, nullptr, 0, 0},
+};
+
+bool setSearchParameter(const std::string &name, int value)
+{
+    for (const SearchParameterInfo *info = searchParameterTable; info->name; ++info)
+    {
+        if (name == info->name)
+        {
+            searchParameters.*(info->field) = std::clamp(value, info->minimum, info->maximum);
+            return true;
+        }
+    }
+    return false;
+}
+
+void printSearchParameterOptions(std::ostream &out)
+{
+    SearchParameters defaults;
+    for (const SearchParameterInfo *info = searchParameterTable; info->name; ++info)
+    {
+        out << "option name " << info->name << " type spin default " << defaults.*(info->field)
+            << " min " << info->minimum << " max " << info->maximum << std::endl;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef SEARCH_PARAMETERS_H
+#define SEARCH_PARAMETERS_H
+
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Search margins that can be tuned without recompiling.
+ *
+ * Every field is also a UCI spin option (see searchParameterTable), so a tuner can change
+ * them with "setoption name <Name> value <x>". They are read by all search threads and must
+ * only be written between searches.
+ */
+struct SearchParameters
+{
+    // Reverse futility: a node is cut when staticEval - margin * depth >= beta
+    int reverseFutilityDepth = 6;
+    int reverseFutilityMargin = 85;
+
+    // Futility: quiet moves are skipped when staticEval + base + margin * depth <= alpha
+    int futilityDepth = 3;
+    int futilityBase = 100;
+    int futilityMargin = 120;
+
+    // Razoring: drop into quiescence when staticEval + base + margin * depth < alpha
+    int razorDepth = 3;
+    int razorBase = 200;
+    int razorMargin = 150;
+
+    // Late move pruning: up to this depth, quiets after (base + depth^2) / 2 moves are skipped,
+    // or after twice that many when the static eval is improving
+    int lateMoveDepth = 5;
+    int lateMoveBase = 3;
+
+    // History pruning: up to this depth, quiets with history below -margin * depth are skipped
+    int historyPruningDepth = 3;
+    int historyPruningMargin = 4000;
+
+    // Singular extension: from this depth, the TT move is extended when every other move fails
+    // below ttScore - margin * depth in a search of half the depth
+    int singularDepth = 6;
+    int singularMargin = 2;
+
+    // Recapture extension: 1 extends, at PV nodes, a capture back on the square of the last capture
+    int recaptureExtension = 1;
+};
+
+/**
+ * @brief UCI name, field and allowed range of one tunable parameter.
+ */
+struct SearchParameterInfo
+{
+    const char *name;
+    int SearchParameters::*field;
+    int minimum;
+    int maximum;
+};
+
+extern SearchParameters searchParameters;
+
+// All tunable parameters; ends with the entry whose name is nullptr
+extern const SearchParameterInfo searchParameterTable[];
+
+// Sets the named parameter, clamped to its range. Returns false for unknown names.
+bool setSearchParameter(const std::string &name, int value);
+
+// Writes one "option name ... type spin" line per parameter
+void printSearchParameterOptions(std::ostream &out);
+
+#endif // SEARCH_PARAMETERS_H
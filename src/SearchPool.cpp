@@ -0,0 +1,213 @@
+#include "SearchPool.h"
+
+SearchPool::SearchPool(const std::shared_ptr<Board> &prototype, int threadCount)
+{
+    createThreads(prototype, threadCount);
+}
+
+SearchPool::~SearchPool()
+{
+    destroyThreads();
+}
+
+void SearchPool::resize(const std::shared_ptr<Board> &prototype, int threadCount)
+{
+    destroyThreads();
+    createThreads(prototype, threadCount);
+}
+
+/**
+ * Allocates the per-thread state up front, then starts the threads. The threads park
+ * in idleLoop until the first search is started.
+ */
+void SearchPool::createThreads(const std::shared_ptr<Board> &prototype, int threadCount)
+{
+    threadCount = std::max(threadCount, 1);
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        auto searchThread = std::make_unique<SearchThread>();
+        searchThread->board = std::make_shared<Board>(prototype);
+        searchThread->evaluate = std::make_unique<Evaluation>(searchThread->board);
+        searchThread->node.stopFlag = i == 0 ? &stopSearch : &stopHelpers;
+        searchThread->node.verbose = i == 0;
+        threads.push_back(std::move(searchThread));
+    }
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads[i]->thread = std::thread(&SearchPool::idleLoop, this, i);
+    }
+}
+
+void SearchPool::destroyThreads()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]()
+                      { return !searching; });
+        quit = true;
+    }
+    wake.notify_all();
+
+    for (auto &searchThread : threads)
+    {
+        searchThread->thread.join();
+    }
+    threads.clear();
+    quit = false;
+}
+
+/**
+ * Copies the root into every thread's board and releases the parked threads.
+ * Waits for a previous search to finish first.
+ */
+void SearchPool::startSearch(const Board &root, int maxDepth, const TimeManager *limits, uint64_t maxNodes,
+                             const std::vector<Move> &rootMoves)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]()
+                      { return !searching; });
+
+        for (auto &searchThread : threads)
+        {
+            searchThread->board->copyPosition(root);
+            searchThread->board->transpositionTable = root.transpositionTable;
+        }
+
+        depth = maxDepth;
+        timeManager = limits;
+        nodeLimit = maxNodes;
+        searchMoves = rootMoves;
+        running = size();
+        searching = true;
+        stopHelpers = false;
+        stopSearch = false;
+        generation++;
+    }
+    wake.notify_all();
+}
+
+SearchResult SearchPool::waitForResult()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&]()
+                  { return !searching; });
+    return lastResult;
+}
+
+void SearchPool::stop()
+{
+    stopSearch = true;
+    stopHelpers = true;
+}
+
+void SearchPool::newGame()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &searchThread : threads)
+    {
+        searchThread->node.newGame();
+    }
+}
+
+void SearchPool::setMultiPV(int lines)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    multiPV = std::max(lines, 1);
+}
+
+std::chrono::steady_clock::time_point SearchPool::firstReportTime() const
+{
+    return threads[0]->node.firstReportTime;
+}
+
+std::string SearchPool::statsJson() const
+{
+#ifdef BOTFISH_STATS
+    return threads[0]->node.stats.toJson();
+#else
+    return "";
+#endif
+}
+
+/**
+ * Body of every pool thread: sleep until a new generation is published, search, report.
+ * The last thread to finish merges the results: the deepest completed iteration wins,
+ * with the main thread preferred on ties, and node counts are summed.
+ */
+void SearchPool::idleLoop(int index)
+{
+    SearchThread &self = *threads[index];
+    uint64_t seenGeneration = 0;
+
+    while (true)
+    {
+        int searchDepth;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]()
+                      { return quit || generation != seenGeneration; });
+            if (quit)
+                return;
+
+            seenGeneration = generation;
+            searchDepth = depth + (index == 0 ? 0 : index % 2);
+            self.node.timeManager = index == 0 ? timeManager : nullptr;
+            self.node.multiPV = index == 0 ? multiPV : 1;
+            self.node.nodeLimit = index == 0 ? nodeLimit : 0;
+            self.node.searchMoves = searchMoves;
+        }
+
+        self.node.newSearch();
+        self.evaluate->pawnTable.resetStats();
+        auto [score, move] = self.node.iterativeDeepening(self.board, searchDepth, self.board->whiteToMove, *self.evaluate);
+        self.result = {self.node.completedDepth, score, move, self.node.nodesExplored,
+                       self.node.quiescenceNodes, self.node.branchingFactor,
+                       self.node.betaCutoffs, self.node.firstMoveCutoffs};
+        const std::vector<Move> &pv = self.node.rootLines.empty() ? std::vector<Move>() : self.node.rootLines[0].pv;
+        self.result.ponder = pv.size() > 1 ? pv[1] : Move{-1, -1};
+        self.result.pawnTableProbes = self.evaluate->pawnTable.getProbes();
+        self.result.pawnTableHits = self.evaluate->pawnTable.getHits();
+
+        if (index == 0)
+        {
+            stopHelpers = true;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (--running == 0)
+        {
+            SearchResult best = threads[0]->result;
+            uint64_t totalNodes = 0;
+            uint64_t totalQuiescenceNodes = 0;
+            uint64_t totalPawnTableProbes = 0;
+            uint64_t totalPawnTableHits = 0;
+
+            for (auto &searchThread : threads)
+            {
+                const SearchResult &result = searchThread->result;
+                totalNodes += result.nodes;
+                totalQuiescenceNodes += result.quiescenceNodes;
+                totalPawnTableProbes += result.pawnTableProbes;
+                totalPawnTableHits += result.pawnTableHits;
+                if (result.depth > best.depth && result.move.from >= 0)
+                {
+                    best = result;
+                }
+            }
+
+            best.nodes = totalNodes;
+            best.quiescenceNodes = totalQuiescenceNodes;
+            best.branchingFactor = threads[0]->result.branchingFactor;
+            best.betaCutoffs = threads[0]->result.betaCutoffs;
+            best.firstMoveCutoffs = threads[0]->result.firstMoveCutoffs;
+            best.pawnTableProbes = totalPawnTableProbes;
+            best.pawnTableHits = totalPawnTableHits;
+            lastResult = best;
+            searching = false;
+            finished.notify_all();
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef SEARCH_POOL_H
+#define SEARCH_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "Evaluation.h"
+#include "Node.h"
+
+/**
+ * @class SearchPool
+ * @brief Search threads created once and parked between searches.
+ *
+ * Every thread owns a board, an evaluator and a Node that are allocated when the pool is
+ * built and reused for every "go", so starting a search only copies the root position and
+ * signals a condition variable. Thread 0 is the main thread; the others are helpers that
+ * search the same root over the shared transposition table (every other helper one ply
+ * deeper) and are stopped as soon as the main thread completes its last iteration.
+ *
+ * stop() may be called from any thread while a search runs; every thread then abandons its
+ * current iteration within a few thousand nodes and the last completed one is reported.
+ */
+class SearchPool
+{
+public:
+    explicit SearchPool(const std::shared_ptr<Board> &prototype, int threadCount = 1);
+    ~SearchPool();
+
+    SearchPool(const SearchPool &) = delete;
+    SearchPool &operator=(const SearchPool &) = delete;
+
+    // Stops the current threads and starts threadCount new ones
+    void resize(const std::shared_ptr<Board> &prototype, int threadCount);
+    int size() const { return static_cast<int>(threads.size()); }
+
+    // Copies the root position into every thread and wakes them up. The main thread obeys
+    // timeManager and nodeLimit if given; every thread only searches searchMoves if not empty.
+    void startSearch(const Board &root, int maxDepth, const TimeManager *timeManager = nullptr,
+                     uint64_t nodeLimit = 0, const std::vector<Move> &searchMoves = {});
+
+    // Blocks until the search started last has finished and returns its result
+    SearchResult waitForResult();
+
+    // Asks the running search to finish as soon as possible; does nothing between searches
+    void stop();
+
+    // Clears every thread's move-ordering heuristics; call between searches
+    void newGame();
+
+    // Number of lines the main thread searches and reports; helpers always search one
+    void setMultiPV(int lines);
+
+    // When the main thread completed its first iteration in the last search
+    std::chrono::steady_clock::time_point firstReportTime() const;
+
+    // Main thread statistics of the last search as JSON; empty unless built with BOTFISH_STATS
+    std::string statsJson() const;
+
+private:
+    struct SearchThread
+    {
+        std::shared_ptr<Board> board;
+        std::unique_ptr<Evaluation> evaluate;
+        Node node;
+        SearchResult result;
+        std::thread thread;
+    };
+
+    void idleLoop(int index);
+    void createThreads(const std::shared_ptr<Board> &prototype, int threadCount);
+    void destroyThreads();
+
+    std::vector<std::unique_ptr<SearchThread>> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    uint64_t generation = 0;
+    int depth = 1;
+    const TimeManager *timeManager = nullptr;
+    uint64_t nodeLimit = 0;
+    std::vector<Move> searchMoves;
+    int multiPV = 1;
+    int running = 0;
+    bool searching = false;
+    bool quit = false;
+
+    std::atomic<bool> stopHelpers{false};
+    std::atomic<bool> stopSearch{false};
+    SearchResult lastResult;
+};
+
+#endif // SEARCH_POOL_H
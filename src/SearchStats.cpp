@@ -0,0 +1,64 @@
+#include "SearchStats.h"
+
+#include <sstream>
+
+static double rate(uint64_t part, uint64_t total)
+{
+    return total == 0 ? 0.0 : static_cast<double>(part) / static_cast<double>(total);
+}
+
+/**
+ * Layout:
+ * {"nodes", "quiescenceNodes", "quiescenceShare",
+ *  "betaCutoffs", "firstMoveCutoffRate", "cutoffsByMoveIndex": [...],
+ *  "tt": [{"depth", "probes", "hits", "cutoffs", "hitRate", "cutoffRate"}, ...],
+ *  "lmr": {"searches", "researches", "researchRate"},
+ *  "nullMove": {"tries", "cutoffs", "successRate"},
+ *  "iterations": [{"depth", "nodes", "timeMs", "nps", "branchingFactor"}, ...]}
+ * Depths that were never probed are left out of "tt".
+ */
+std::string SearchStats::toJson() const
+{
+    std::ostringstream out;
+
+    uint64_t cutoffs = 0;
+    for (uint64_t count : cutoffsByMoveIndex)
+        cutoffs += count;
+
+    out << "{\"nodes\":" << nodes << ",\"quiescenceNodes\":" << quiescenceNodes
+        << ",\"quiescenceShare\":" << rate(quiescenceNodes, nodes)
+        << ",\"betaCutoffs\":" << cutoffs << ",\"firstMoveCutoffRate\":" << rate(cutoffsByMoveIndex[0], cutoffs)
+        << ",\"cutoffsByMoveIndex\":[";
+    for (int i = 0; i < MOVE_INDEX_SLOTS; i++)
+        out << (i ? "," : "") << cutoffsByMoveIndex[i];
+
+    out << "],\"tt\":[";
+    bool first = true;
+    for (int d = 0; d < DEPTH_SLOTS; d++)
+    {
+        if (ttProbes[d] == 0)
+            continue;
+        out << (first ? "" : ",") << "{\"depth\":" << d << ",\"probes\":" << ttProbes[d] << ",\"hits\":" << ttHits[d]
+            << ",\"cutoffs\":" << ttCutoffs[d] << ",\"hitRate\":" << rate(ttHits[d], ttProbes[d])
+            << ",\"cutoffRate\":" << rate(ttCutoffs[d], ttProbes[d]) << "}";
+        first = false;
+    }
+
+    out << "],\"lmr\":{\"searches\":" << reducedSearches << ",\"researches\":" << reducedResearches
+        << ",\"researchRate\":" << rate(reducedResearches, reducedSearches) << "}";
+    out << ",\"nullMove\":{\"tries\":" << nullMoveTries << ",\"cutoffs\":" << nullMoveCutoffs
+        << ",\"successRate\":" << rate(nullMoveCutoffs, nullMoveTries) << "}";
+
+    out << ",\"iterations\":[";
+    for (size_t i = 0; i < iterations.size(); i++)
+    {
+        const Iteration &iteration = iterations[i];
+        uint64_t nps = iteration.nodes * 1000 / static_cast<uint64_t>(iteration.timeMs > 0 ? iteration.timeMs : 1);
+        out << (i ? "," : "") << "{\"depth\":" << iteration.depth << ",\"nodes\":" << iteration.nodes
+            << ",\"timeMs\":" << iteration.timeMs << ",\"nps\":" << nps
+            << ",\"branchingFactor\":" << iteration.branchingFactor << "}";
+    }
+    out << "]}";
+
+    return out.str();
+}
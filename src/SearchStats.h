@@ -0,0 +1,85 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Search statistics for tuning. Only compiled in when BOTFISH_STATS is defined (CMake option
+ * of the same name); otherwise every SEARCH_STAT statement expands to nothing and Node has no
+ * statistics member, so release builds pay nothing for them.
+ */
+#ifdef BOTFISH_STATS
+#define SEARCH_STAT(...) __VA_ARGS__
+#else
+#define SEARCH_STAT(...) ((void)0)
+#endif
+
+/**
+ * @brief Counters collected by one search thread during one iterativeDeepening call.
+ *
+ * Move indices and depths beyond the table sizes are counted in the last slot.
+ */
+struct SearchStats
+{
+    static constexpr int MOVE_INDEX_SLOTS = 32;
+    static constexpr int DEPTH_SLOTS = 64;
+
+    struct Iteration
+    {
+        int depth;
+        uint64_t nodes;
+        int64_t timeMs;
+        double branchingFactor;
+    };
+
+    uint64_t cutoffsByMoveIndex[MOVE_INDEX_SLOTS] = {};
+
+    uint64_t ttProbes[DEPTH_SLOTS] = {};
+    uint64_t ttHits[DEPTH_SLOTS] = {};
+    uint64_t ttCutoffs[DEPTH_SLOTS] = {};
+
+    uint64_t reducedSearches = 0;
+    uint64_t reducedResearches = 0;
+
+    uint64_t nullMoveTries = 0;
+    uint64_t nullMoveCutoffs = 0;
+
+    uint64_t nodes = 0;
+    uint64_t quiescenceNodes = 0;
+
+    std::vector<Iteration> iterations;
+
+    void clear() { *this = SearchStats(); }
+
+    void cutoff(int moveIndex) { cutoffsByMoveIndex[slot(moveIndex, MOVE_INDEX_SLOTS)]++; }
+
+    void ttProbe(int depth, bool hit, bool cutoff)
+    {
+        int d = slot(depth, DEPTH_SLOTS);
+        ttProbes[d]++;
+        ttHits[d] += hit;
+        ttCutoffs[d] += cutoff;
+    }
+
+    void reducedSearch(bool researched)
+    {
+        reducedSearches++;
+        reducedResearches += researched;
+    }
+
+    void nullMove(bool cutoff)
+    {
+        nullMoveTries++;
+        nullMoveCutoffs += cutoff;
+    }
+
+    // Single-line JSON object with the raw counters and the rates derived from them
+    std::string toJson() const;
+
+private:
+    static int slot(int value, int slots) { return value < 0 ? 0 : value >= slots ? slots - 1 : value; }
+};
+
+#endif // SEARCH_STATS_H
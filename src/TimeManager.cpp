@@ -0,0 +1,145 @@
+#include "TimeManager.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+// Moves the remaining clock is split over when the GUI does not send movestogo
+constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+// Share of the remaining clock (percent) the soft and hard limits may take at most
+constexpr int64_t MAX_SOFT_SHARE = 50;
+constexpr int64_t MAX_HARD_SHARE = 80;
+
+// The hard limit is this many times the soft limit, within MAX_HARD_SHARE
+constexpr int64_t HARD_LIMIT_FACTOR = 4;
+
+// Soft limit scale (percent) by how many iterations in a row returned the same best move
+constexpr int STABILITY_SCALE[] = {250, 140, 110, 90, 75};
+
+// A score drop of this many centipawns or more doubles the soft limit
+constexpr int MAX_SCORE_DROP = 100;
+
+static bool isMoveToken(const std::string &token)
+{
+    return (token.size() == 4 || token.size() == 5) && token[0] >= 'a' && token[0] <= 'h' && token[1] >= '1' &&
+           token[1] <= '8' && token[2] >= 'a' && token[2] <= 'h' && token[3] >= '1' && token[3] <= '8';
+}
+
+/**
+ * Reads "wtime", "btime", "winc", "binc", "movestogo", "movetime", "depth", "nodes", "mate",
+ * "infinite", "ponder" and "searchmoves".
+ */
+SearchLimits SearchLimits::parse(const std::string &parameters)
+{
+    SearchLimits limits;
+    std::istringstream iss(parameters);
+    std::string token;
+    bool inMoveList = false;
+
+    while (iss >> token)
+    {
+        // The searchmoves list runs until the next keyword
+        if (inMoveList && isMoveToken(token))
+        {
+            limits.searchMoves.push_back(token);
+            continue;
+        }
+        inMoveList = false;
+
+        if (token == "wtime")
+            iss >> limits.wtime;
+        else if (token == "btime")
+            iss >> limits.btime;
+        else if (token == "winc")
+            iss >> limits.winc;
+        else if (token == "binc")
+            iss >> limits.binc;
+        else if (token == "movestogo")
+            iss >> limits.movestogo;
+        else if (token == "movetime")
+            iss >> limits.movetime;
+        else if (token == "depth")
+            iss >> limits.depth;
+        else if (token == "nodes")
+            iss >> limits.nodes;
+        else if (token == "mate")
+            iss >> limits.mate;
+        else if (token == "infinite")
+            limits.infinite = true;
+        else if (token == "ponder")
+            limits.ponder = true;
+        else if (token == "searchmoves")
+            inMoveList = true;
+        else
+            std::cerr << "Ignoring go parameter: " << token << std::endl;
+    }
+    return limits;
+}
+
+/**
+ * With movetime both limits are the given time. Otherwise the soft limit is an even share of
+ * the remaining clock over movestogo (or DEFAULT_MOVES_TO_GO) moves plus most of the
+ * increment, and the hard limit a multiple of it; both are capped to a share of the clock so
+ * a single move can never flag. The move overhead is taken off the clock first.
+ */
+void TimeManager::start(const SearchLimits &limits, bool white, int moveOverhead)
+{
+    startTicks = std::chrono::steady_clock::now().time_since_epoch().count();
+    pondering = limits.ponder;
+    timed = limits.hasTimeControl() && !limits.infinite;
+    fixedTime = limits.movetime > 0;
+
+    if (!timed)
+        return;
+
+    if (fixedTime)
+    {
+        softLimit = hardLimit = std::max<int64_t>(limits.movetime - moveOverhead, 1);
+        return;
+    }
+
+    int64_t time = white ? limits.wtime : limits.btime;
+    int64_t increment = white ? limits.winc : limits.binc;
+    int64_t available = std::max<int64_t>(time - moveOverhead, 1);
+    int movesToGo = limits.movestogo > 0 ? std::min(limits.movestogo, DEFAULT_MOVES_TO_GO) : DEFAULT_MOVES_TO_GO;
+
+    softLimit = std::min(available / movesToGo + increment * 3 / 4, available * MAX_SOFT_SHARE / 100);
+    softLimit = std::max<int64_t>(softLimit, 1);
+    hardLimit = std::min(softLimit * HARD_LIMIT_FACTOR, available * MAX_HARD_SHARE / 100);
+    hardLimit = std::max(hardLimit, softLimit);
+}
+
+void TimeManager::ponderhit()
+{
+    startTicks = std::chrono::steady_clock::now().time_since_epoch().count();
+    pondering = false;
+}
+
+int64_t TimeManager::elapsed() const
+{
+    std::chrono::steady_clock::duration start(startTicks.load(std::memory_order_relaxed));
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch() - start).count();
+}
+
+/**
+ * An unstable best move or a falling score means the last iterations changed their mind, so
+ * the next one is likely worth its time; a move that survived several iterations is not
+ * going to change. The scaled limit never exceeds the hard limit. A fixed movetime is used
+ * in full.
+ */
+bool TimeManager::softLimitReached(int bestMoveStability, int scoreDrop) const
+{
+    if (!timed || pondering.load(std::memory_order_relaxed))
+        return false;
+    if (fixedTime)
+        return elapsed() >= hardLimit;
+
+    constexpr int lastStability = static_cast<int>(std::size(STABILITY_SCALE)) - 1;
+    int64_t stabilityScale = STABILITY_SCALE[std::clamp(bestMoveStability, 0, lastStability)];
+    int64_t scoreScale = 100 + 100 * std::clamp(scoreDrop, 0, MAX_SCORE_DROP) / MAX_SCORE_DROP;
+
+    int64_t limit = std::min(softLimit * stabilityScale * scoreScale / 10000, hardLimit);
+    return elapsed() >= limit;
+}
@@ -0,0 +1,95 @@
+#ifndef TIME_MANAGER_H
+#define TIME_MANAGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Limits of one search as given by the UCI "go" command. Times are in milliseconds,
+ * 0 when not given.
+ */
+struct SearchLimits
+{
+    int64_t wtime = 0;
+    int64_t btime = 0;
+    int64_t winc = 0;
+    int64_t binc = 0;
+    int movestogo = 0;
+    int64_t movetime = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    int mate = 0;
+    bool infinite = false;
+    bool ponder = false;
+
+    // Moves after "searchmoves" in coordinate notation; only these are searched at the root
+    std::vector<std::string> searchMoves;
+
+    // Parses the parameters following "go"; unknown tokens are reported and skipped
+    static SearchLimits parse(const std::string &parameters);
+
+    bool hasTimeControl() const { return wtime > 0 || btime > 0 || movetime > 0; }
+};
+
+/**
+ * @class TimeManager
+ * @brief Decides how long a timed search may run.
+ *
+ * Two limits are derived from the clock when the search starts. The hard limit is polled by
+ * the search every few thousand nodes and aborts the iteration in progress. The soft limit is
+ * only checked between iterations: no new iteration starts once it has passed. It is stretched
+ * while the best move keeps changing or the score drops, and shrunk when the best move has
+ * been stable for several iterations.
+ *
+ * A ponder search has its limits computed up front but ignores them until ponderhit(), which
+ * may be called from another thread while the search runs and restarts the clock.
+ */
+class TimeManager
+{
+public:
+    /**
+     * @brief Starts the clock and computes the limits for the side to move.
+     *
+     * @param limits Parsed "go" parameters.
+     * @param white True if white is to move.
+     * @param moveOverhead Milliseconds reserved per move for GUI and transport latency.
+     */
+    void start(const SearchLimits &limits, bool white, int moveOverhead);
+
+    // Whether the search has a time limit at all
+    bool isTimed() const { return timed; }
+
+    // Milliseconds since start(), or since ponderhit() after a ponder search
+    int64_t elapsed() const;
+
+    // True once the search must stop immediately; polled inside the search
+    bool hardLimitReached() const { return timed && !pondering.load(std::memory_order_relaxed) && elapsed() >= hardLimit; }
+
+    // The opponent played the expected move: the limits apply from now on
+    void ponderhit();
+
+    /**
+     * @brief Called after every completed iteration; true if the next one should not start.
+     *
+     * @param bestMoveStability Consecutive iterations that returned the same best move.
+     * @param scoreDrop Centipawns the score fell since the previous iteration, negative if it rose.
+     */
+    bool softLimitReached(int bestMoveStability, int scoreDrop) const;
+
+    int64_t getSoftLimit() const { return softLimit; }
+    int64_t getHardLimit() const { return hardLimit; }
+
+private:
+    // Steady clock ticks at start() or ponderhit()
+    std::atomic<std::chrono::steady_clock::rep> startTicks{0};
+    std::atomic<bool> pondering{false};
+    int64_t softLimit = 0;
+    int64_t hardLimit = 0;
+    bool timed = false;
+    bool fixedTime = false;
+};
+
+#endif // TIME_MANAGER_H
@@ -0,0 +1,167 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define BOTFISH_HAS_SHM 1
+#endif
+
+constexpr size_t TABLE_BYTES = sizeof(TTEntry) * static_cast<size_t>(TABLE_SIZE);
+
+TranspositionTable::TranspositionTable()
+    : heapEntries(new TTEntry[TABLE_SIZE])
+{
+    entries = heapEntries.get();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    unmapShared();
+}
+
+/**
+ * @brief Folds the payload of an entry into 64 bits for lockless verification.
+ */
+uint64_t TranspositionTable::checksum(const TTEntry &entry)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(entry.evaluation)) << 32) ^
+           (static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 24) ^
+           (static_cast<uint64_t>(static_cast<uint8_t>(entry.bestFrom)) << 16) ^
+           (static_cast<uint64_t>(static_cast<uint8_t>(entry.bestTo)) << 8) ^
+           static_cast<uint64_t>(entry.flag);
+}
+
+/**
+ * @brief Probes the table for an entry usable at the given depth and window.
+ *
+ * The entry is copied out before it is verified so that a concurrent writer can only
+ * make the probe miss, never return a mix of two positions.
+ *
+ * Whenever the position is found, entry receives the stored result so the caller can still
+ * use its best move for ordering when the score itself is not usable.
+ *
+ * @return true if the stored result is deep enough and its bound decides the window.
+ */
+bool TranspositionTable::probe(uint64_t hash, int depth, int alpha, int beta, TTEntry &entry)
+{
+    TTEntry result = entries[hash % TABLE_SIZE];
+
+    if ((result.hash ^ checksum(result)) != hash) // Ensure we are checking the correct position
+    {
+        return false;
+    }
+
+    entry = result;
+    entry.hash = hash;
+
+    if (result.depth < depth) // Only use if stored depth is sufficient
+    {
+        return false;
+    }
+
+    return result.flag == TTFlag::EXACT ||
+           (result.flag == TTFlag::LOWERBOUND && result.evaluation >= beta) ||
+           (result.flag == TTFlag::UPPERBOUND && result.evaluation <= alpha);
+}
+
+/**
+ * @brief Stores a search result, replacing whatever occupied the slot.
+ *
+ * The bound type is derived from the window the node was searched with.
+ */
+void TranspositionTable::store(uint64_t hash, int depth, int eval, int alpha, int beta, int from, int to)
+{
+    TTEntry entry;
+    entry.evaluation = eval;
+    entry.depth = depth;
+    entry.bestFrom = from;
+    entry.bestTo = to;
+    if (eval <= alpha)
+        entry.flag = TTFlag::UPPERBOUND; // Eval is worse than or equal to beta, we can't improve
+    else if (eval >= beta)
+        entry.flag = TTFlag::LOWERBOUND; // Eval is better than or equal to alpha, we can't worsen
+    else
+        entry.flag = TTFlag::EXACT;
+    entry.hash = hash ^ checksum(entry);
+
+    entries[hash % TABLE_SIZE] = entry;
+}
+
+void TranspositionTable::clear()
+{
+    std::fill(entries, entries + TABLE_SIZE, TTEntry{});
+}
+
+bool TranspositionTable::attachShared(const std::string &name, bool create)
+{
+#ifdef BOTFISH_HAS_SHM
+    detachShared();
+
+    int fd = shm_open(name.c_str(), create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+    if (fd < 0)
+    {
+        std::cerr << "Error: shm_open failed for " << name << std::endl;
+        return false;
+    }
+
+    if (create && ftruncate(fd, static_cast<off_t>(TABLE_BYTES)) != 0)
+    {
+        std::cerr << "Error: could not size shared hash " << name << std::endl;
+        close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void *memory = mmap(nullptr, TABLE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED)
+    {
+        std::cerr << "Error: mmap failed for shared hash " << name << std::endl;
+        close(fd);
+        if (create)
+            shm_unlink(name.c_str());
+        return false;
+    }
+
+    // A fresh segment is zero filled, which probes as empty.
+    entries = static_cast<TTEntry *>(memory);
+    heapEntries.reset();
+    sharedFd = fd;
+    ownsShared = create;
+    shmName = name;
+    return true;
+#else
+    std::cerr << "Error: shared hash is not supported on this platform" << std::endl;
+    return false;
+#endif
+}
+
+void TranspositionTable::detachShared()
+{
+    if (!isShared())
+        return;
+
+    unmapShared();
+    heapEntries.reset(new TTEntry[TABLE_SIZE]);
+    entries = heapEntries.get();
+}
+
+void TranspositionTable::unmapShared()
+{
+#ifdef BOTFISH_HAS_SHM
+    if (sharedFd < 0)
+        return;
+
+    munmap(entries, TABLE_BYTES);
+    close(sharedFd);
+    if (ownsShared)
+        shm_unlink(shmName.c_str());
+
+    sharedFd = -1;
+    ownsShared = false;
+    shmName.clear();
+    entries = nullptr;
+#endif
+}
@@ -0,0 +1,76 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+constexpr int TABLE_SIZE = 20971521;
+
+enum TTFlag
+{
+    EXACT,
+    LOWERBOUND,
+    UPPERBOUND
+};
+struct TTEntry
+{
+    int evaluation;
+    int depth;
+    int bestFrom;
+    int bestTo;
+    TTFlag flag;
+    uint64_t hash;
+
+    TTEntry(int eval = 0, int d = 0, TTFlag f = EXACT, int bf = -1, int bt = -1)
+        : evaluation(eval), depth(d), flag(f), bestFrom(bf), bestTo(bt), hash(0) {}
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed size hash table of search results shared by every searcher of a position.
+ *
+ * The table lives either on the heap (default) or in a POSIX shared memory segment so that
+ * several engine processes can search the same position and reuse each other's work.
+ * Entries are written without locks; the stored key is XORed with the entry data so a
+ * torn write from another thread or process is detected on probe and treated as a miss.
+ */
+class TranspositionTable
+{
+public:
+    TranspositionTable();
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    bool probe(uint64_t hash, int depth, int alpha, int beta, TTEntry &entry);
+    void store(uint64_t hash, int depth, int eval, int alpha, int beta, int from, int to);
+    void clear();
+
+    /**
+     * @brief Moves the table into a named POSIX shared memory segment.
+     *
+     * @param name Segment name passed to shm_open (e.g. "/botfish-tt").
+     * @param create True for the process that owns the segment, false to attach to an existing one.
+     * @return true on success. On failure the table keeps using its heap storage.
+     */
+    bool attachShared(const std::string &name, bool create);
+    void detachShared();
+    bool isShared() const { return sharedFd >= 0; }
+    const std::string &sharedName() const { return shmName; }
+
+private:
+    static uint64_t checksum(const TTEntry &entry);
+    void unmapShared();
+
+    TTEntry *entries = nullptr;
+    std::unique_ptr<TTEntry[]> heapEntries;
+
+    int sharedFd = -1;
+    bool ownsShared = false;
+    std::string shmName;
+};
+
+#endif // TRANSPOSITION_TABLE_H
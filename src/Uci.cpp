@@ -1,5 +1,13 @@
 #include "Uci.h"
 
+#include <algorithm>
+
+// Latency targets for a "go" on a trivial position, checked by the "latency" command
+constexpr long long GO_TO_INFO_BUDGET_US = 1000;
+constexpr long long GO_TO_BESTMOVE_BUDGET_US = 2000;
+
+constexpr const char *START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
 /**
  * Initializes the UCI engine by printing engine details and setting up the board.
  */
@@ -10,6 +18,15 @@ void Uci::init()
     std::cout << "uciok" << std::endl;
 
     board = std::make_shared<Board>(); // Initialize the internal board
+    pool = std::make_unique<SearchPool>(board);
+}
+
+Uci::~Uci()
+{
+    if (pool)
+    {
+        handleStop();
+    }
 }
 
 /**
@@ -25,6 +42,12 @@ void Uci::processCommand(const std::string &command)
     std::string cmd;
     iss >> cmd;
 
+    // Only isready, stop, ponderhit and quit are answered while a search runs; the rest waits for it
+    if (cmd != "isready" && cmd != "stop" && cmd != "ponderhit" && cmd != "quit")
+    {
+        waitForSearch();
+    }
+
     if (cmd == "uci")
     {
         handleUci();
@@ -59,10 +82,36 @@ void Uci::processCommand(const std::string &command)
     {
         handleStop();
     }
+    else if (cmd == "ponderhit")
+    {
+        handlePonderhit();
+    }
     else if (cmd == "quit")
     {
         handleQuit();
     }
+    else if (cmd == "latency")
+    {
+        std::string parameters;
+        std::getline(iss, parameters);
+        handleLatency(parameters);
+    }
+    else if (cmd == "bench")
+    {
+        std::string parameters;
+        std::getline(iss, parameters);
+        handleBench(parameters);
+    }
+    else if (cmd == "stats")
+    {
+        handleStats();
+    }
+    else if (cmd == "tactics")
+    {
+        std::string parameters;
+        std::getline(iss, parameters);
+        handleTactics(parameters);
+    }
     else
     {
         std::cerr << "Unknown command: " << command << std::endl;
@@ -76,6 +125,12 @@ void Uci::handleUci()
 {
     std::cout << "id name MyChessEngine" << std::endl;
     std::cout << "id author YourName" << std::endl;
+    std::cout << "option name Depth type spin default 3 min 1 max 64" << std::endl;
+    std::cout << "option name Threads type spin default 1 min 1 max 256" << std::endl;
+    std::cout << "option name Cluster type string default <empty>" << std::endl;
+    std::cout << "option name Move Overhead type spin default 30 min 0 max 5000" << std::endl;
+    std::cout << "option name MultiPV type spin default 1 min 1 max 256" << std::endl;
+    printSearchParameterOptions(std::cout);
     std::cout << "uciok" << std::endl;
 }
 
@@ -90,7 +145,10 @@ void Uci::handleIsReady()
 /**
  * Handles the "setoption" command, allowing configuration of engine parameters.
  * 
- * @param option The option string received (expected format: "setoption <value>").
+ * Accepts the UCI form "setoption name <id> value <x>" as well as the short
+ * "setoption <depth>" form the GUI sends.
+ *
+ * @param option The option string received after "setoption".
  */
 void Uci::handleSetOption(const std::string &option)
 {
@@ -100,24 +158,107 @@ void Uci::handleSetOption(const std::string &option)
         return;
     }
 
-    size_t spacePos = option.find(" ");
+    std::istringstream iss(option);
+    std::string token;
+    iss >> token;
 
-    if (spacePos != std::string::npos)
+    if (token != "name")
     {
-        std::string depthValue = option.substr(spacePos + 1);
         try
         {
-            depth = std::stoi(depthValue);
-            std::cout << "Option set: depth = " << depth << std::endl;
+            depth = std::stoi(token);
+            std::cout << "info string depth = " << depth << std::endl;
         }
         catch (const std::invalid_argument &e)
         {
-            std::cerr << "Invalid depth value received: " << depthValue << std::endl;
+            std::cerr << "Invalid depth value received: " << token << std::endl;
+        }
+        return;
+    }
+
+    std::string name;
+    while (iss >> token && token != "value")
+    {
+        name += (name.empty() ? "" : " ") + token;
+    }
+    std::string value;
+    std::getline(iss, value);
+    value = trimLeadingSpace(value);
+
+    if (name == "Depth")
+    {
+        try
+        {
+            depth = std::stoi(value);
+            std::cout << "info string depth = " << depth << std::endl;
+        }
+        catch (const std::invalid_argument &e)
+        {
+            std::cerr << "Invalid depth value received: " << value << std::endl;
+        }
+    }
+    else if (name == "Threads")
+    {
+        try
+        {
+            pool->resize(board, std::clamp(std::stoi(value), 1, 256));
+            std::cout << "info string threads = " << pool->size() << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Invalid thread count received: " << value << std::endl;
+        }
+    }
+    else if (name == "Move Overhead")
+    {
+        try
+        {
+            moveOverhead = std::clamp(std::stoi(value), 0, 5000);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Invalid move overhead received: " << value << std::endl;
+        }
+    }
+    else if (name == "MultiPV")
+    {
+        try
+        {
+            pool->setMultiPV(std::clamp(std::stoi(value), 1, 256));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Invalid MultiPV value received: " << value << std::endl;
+        }
+    }
+    else if (name == "Cluster")
+    {
+        if (value.empty() || value == "<empty>")
+        {
+            cluster.shutdown();
+            board->transpositionTable->detachShared();
+        }
+        else if (cluster.start(value, board->transpositionTable))
+        {
+            std::cout << "info string cluster leader listening on " << value << std::endl;
         }
     }
     else
     {
-        std::cerr << "Invalid option command format! Expected format: 'depth <value>'" << std::endl;
+        bool known;
+        try
+        {
+            known = setSearchParameter(name, std::stoi(value));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Invalid value for " << name << ": " << value << std::endl;
+            return;
+        }
+        if (!known)
+        {
+            std::cerr << "Unknown option: " << name << std::endl;
+        }
     }
 }
 
@@ -126,12 +267,24 @@ void Uci::handleSetOption(const std::string &option)
  */
 void Uci::handleUciNewGame()
 {
+    auto table = board->transpositionTable;
     board = std::make_shared<Board>(); // Reset board
-    std::cout << "New game started" << std::endl;
+    pool->newGame();
+
+    if (cluster.isRunning())
+    {
+        // Keep the workers on the shared table
+        table->clear();
+        board->transpositionTable = table;
+    }
+    std::cout << "info string new game started" << std::endl;
 }
 
 /**
  * Handles the "position" command by setting the board position from a FEN string.
+ *
+ * Accepts "startpos [moves ...]", "fen <fen> [moves ...]" and a bare FEN. With startpos or
+ * fen the repetition history is rebuilt from the listed moves; a bare FEN keeps it.
  * 
  * @param position The FEN string received.
  */
@@ -148,8 +301,54 @@ void Uci::handlePosition(const std::string &position)
         std::cerr << "Error: Received empty position string!" << std::endl;
         return;
     }
-    board->setFen(trimLeadingSpace(position));
-    std::cout << "Position set:" << position << std::endl;
+    std::string fen = trimLeadingSpace(position);
+    std::string moves;
+    size_t movesAt = fen.find("moves");
+    if (movesAt != std::string::npos)
+    {
+        moves = fen.substr(movesAt + 5);
+        fen = fen.substr(0, movesAt);
+    }
+
+    if (fen.rfind("startpos", 0) == 0)
+    {
+        fen = START_FEN;
+        board->gameFensHistory.clear();
+    }
+    else if (fen.rfind("fen", 0) == 0)
+    {
+        fen = trimLeadingSpace(fen.substr(3));
+        board->gameFensHistory.clear();
+    }
+    board->setFen(fen);
+
+    std::istringstream iss(moves);
+    std::string move;
+    while (iss >> move)
+    {
+        // Promotions are always to a queen; replaying an underpromotion as one would leave the
+        // board out of step with the game, so it is rejected like an invalid move
+        if (move.size() > 4 && move[4] != 'q')
+        {
+            std::cerr << "Error: Underpromotion is not supported: " << move << std::endl;
+            break;
+        }
+        auto [from, to] = board->parseMove(move.substr(0, 4));
+        if (from < 0 || to < 0)
+        {
+            std::cerr << "Error: Invalid move in position command: " << move << std::endl;
+            break;
+        }
+        // movePiece records the cached hash in the repetition history, so it must be current
+        board->computeZobristHash();
+        board->movePiece(from, to);
+    }
+    board->moveCount = 0;
+    std::cout << "info string position set:" << position << std::endl;
+    if (board->isThreefoldRepetition())
+    {
+        std::cout << "info string draw by repetition" << std::endl;
+    }
 }
 
 /**
@@ -166,40 +365,421 @@ std::string Uci::trimLeadingSpace(const std::string &str)
 
 /**
  * Handles the "go" command, initiating move search using iterative deepening.
+ *
+ * With a clock (wtime/btime or movetime) the time manager decides when to stop and the depth
+ * is only limited by "depth" if given. Without one, "depth" or else the Depth option is used;
+ * "infinite" searches until the maximum depth. "nodes" stops the main thread after that many
+ * nodes, which is reproducible with one thread; "mate n" searches 2n - 1 plies; "searchmoves"
+ * restricts the root moves. "ponder" ignores the clock until ponderhit, and
+ * after ponder or infinite the best move is held back until ponderhit or stop.
+ *
+ * Returns as soon as the search threads are running. The best move is printed and played by
+ * a separate thread once the search ends, so "stop" and "isready" are read meanwhile.
  * 
  * @param parameters Search parameters (e.g., time controls, depth constraints).
  */
 void Uci::handleGo(const std::string &parameters)
 {
-    std::cout << "Go command received with parameters: " << parameters << std::endl;
-
     if (!board)
     {
         std::cerr << "Error: Board is uninitialized!" << std::endl;
         return;
     }
 
-    Node root;
-    Evaluation evaluate(board);
+    SearchLimits limits = SearchLimits::parse(parameters);
+    timeManager.start(limits, board->whiteToMove, moveOverhead);
 
-    auto start = std::chrono::high_resolution_clock::now();
+    int maxDepth = depth;
+    if (limits.depth > 0)
+        maxDepth = limits.depth;
+    else if (limits.mate > 0)
+        maxDepth = std::min(2 * limits.mate - 1, MAX_PLY - 1);
+    else if (timeManager.isTimed() || limits.infinite || limits.nodes > 0)
+        maxDepth = MAX_PLY - 1;
 
-    auto [bestScore, bestmove] = root.iterativeDeepening(board, depth, board->whiteToMove, evaluate);
+    // Unknown or illegal searchmoves entries are dropped; with none left every move is searched
+    std::vector<Move> searchMoves;
+    Move legalMoves[256];
+    int legalCount = board->getAllLegalMovesAsArray(legalMoves, board->whiteToMove).from;
+    for (const std::string &text : limits.searchMoves)
+    {
+        auto [from, to] = board->parseMove(text.substr(0, 4));
+        if (std::find(legalMoves, legalMoves + legalCount, Move{from, to}) != legalMoves + legalCount)
+            searchMoves.push_back({from, to});
+        else
+            std::cerr << "Ignoring illegal searchmoves entry: " << text << std::endl;
+    }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration = end - start;
+    {
+        std::lock_guard<std::mutex> lock(bestMoveMutex);
+        holdBestMove = limits.ponder || limits.infinite;
+    }
 
-    std::cout << "Search took " << duration.count() << " seconds." << std::endl;
+    launchSearch(maxDepth, &timeManager, limits.nodes, searchMoves);
+    searchThread = std::thread([this]()
+                               { finishGo(); });
+}
 
+/**
+ * Waits for the search started by "go", then reports and plays its best move. Runs on
+ * searchThread.
+ */
+void Uci::finishGo()
+{
+    SearchResult result = collectSearch();
+
+    // After "go ponder" or "go infinite" the best move may only be sent after stop or ponderhit
+    {
+        std::unique_lock<std::mutex> lock(bestMoveMutex);
+        bestMoveReleased.wait(lock, [&]()
+                              { return !holdBestMove; });
+    }
+    Move bestmove = result.move;
+
+    // Mated or stalemated: the GUI still waits for a bestmove, so send the UCI null move
     if (bestmove.from == -1 || bestmove.to == -1)
     {
         std::cerr << "Error: No valid move found!" << std::endl;
+        std::cout << "bestmove 0000" << std::endl;
         return;
     }
 
-    std::cout << "bestmove " << board->moveToString(bestmove.from, bestmove.to) << std::endl;
-
     applyBestMove(bestmove);
+    Move reply = expectedReply(result.ponder);
+
+    std::cout << "bestmove " << board->moveToString(bestmove.from, bestmove.to);
+    if (reply.from >= 0)
+    {
+        std::cout << " ponder " << board->moveToString(reply.from, reply.to);
+    }
+    std::cout << std::endl;
+    SEARCH_STAT(handleStats());
+}
+
+/**
+ * Move to ponder on after our best move: the second move of the principal variation, or the
+ * hash move of the position after our move when the PV is too short (e.g. from a cluster
+ * worker). Expects the best move to have been played on the board.
+ *
+ * @param pvReply Second PV move of the search result, {-1, -1} if there is none.
+ * @return The expected reply if it is legal, otherwise {-1, -1}.
+ */
+Move Uci::expectedReply(Move pvReply)
+{
+    Move reply = pvReply;
+    if (reply.from < 0)
+    {
+        board->computeZobristHash();
+        TTEntry entry;
+        board->probeTranspositionTable(board->getZobristHash(), 0, -SCORE_INFINITE, SCORE_INFINITE, entry);
+        reply = {entry.bestFrom, entry.bestTo};
+    }
+
+    Move moves[256];
+    int moveCount = board->getAllLegalMovesAsArray(moves, board->whiteToMove).from;
+    for (int i = 0; i < moveCount; i++)
+    {
+        if (moves[i] == reply)
+            return reply;
+    }
+    return {-1, -1};
+}
+
+/**
+ * Handles the "stats" command. Prints the main thread's statistics of the last search as one
+ * JSON object after "info string stats", so GUIs that log engine output can keep it. A build
+ * without BOTFISH_STATS collects nothing and says so.
+ */
+void Uci::handleStats()
+{
+    std::string json = pool->statsJson();
+    if (json.empty())
+    {
+        std::cout << "info string stats unavailable, build with BOTFISH_STATS" << std::endl;
+        return;
+    }
+    std::cout << "info string stats " << json << std::endl;
+}
+
+/**
+ * Handles the "latency" command. Runs a depth 1 search on a king and pawn ending a number
+ * of times (default 50) through the same path as "go" and reports the time from go to the
+ * first iteration report and to the best move, against GO_TO_INFO_BUDGET_US and
+ * GO_TO_BESTMOVE_BUDGET_US. The current position is restored afterwards.
+ *
+ * @param parameters Optional number of runs.
+ */
+void Uci::handleLatency(const std::string &parameters)
+{
+    int runs = 50;
+    std::istringstream iss(parameters);
+    iss >> runs;
+    runs = std::max(runs, 1);
+
+    std::string savedFen = board->getFen();
+    auto savedHistory = board->gameFensHistory;
+    board->setFen("8/8/4k3/8/8/8/4P3/4K3 w - - 0 1");
+    board->gameFensHistory.clear();
+
+    long long worstInfo = 0, worstBestmove = 0, totalInfo = 0, totalBestmove = 0;
+
+    for (int i = 0; i < runs; i++)
+    {
+        auto go = std::chrono::steady_clock::now();
+        SearchResult result = searchPosition(1);
+        std::cout << "bestmove " << board->moveToString(result.move.from, result.move.to) << std::endl;
+        auto done = std::chrono::steady_clock::now();
+
+        long long toInfo = std::chrono::duration_cast<std::chrono::microseconds>(pool->firstReportTime() - go).count();
+        long long toBestmove = std::chrono::duration_cast<std::chrono::microseconds>(done - go).count();
+        worstInfo = std::max(worstInfo, toInfo);
+        worstBestmove = std::max(worstBestmove, toBestmove);
+        totalInfo += toInfo;
+        totalBestmove += toBestmove;
+    }
+
+    std::cout << "go -> first info (us): avg " << totalInfo / runs << " max " << worstInfo
+              << " budget " << GO_TO_INFO_BUDGET_US << (worstInfo <= GO_TO_INFO_BUDGET_US ? " PASS" : " FAIL") << std::endl;
+    std::cout << "go -> bestmove (us)  : avg " << totalBestmove / runs << " max " << worstBestmove
+              << " budget " << GO_TO_BESTMOVE_BUDGET_US << (worstBestmove <= GO_TO_BESTMOVE_BUDGET_US ? " PASS" : " FAIL") << std::endl;
+
+    board->setFen(savedFen);
+    board->gameFensHistory = savedHistory;
+}
+
+/**
+ * Searches the current position to maxDepth and waits for the result.
+ *
+ * @param maxDepth Depth of the last iterative deepening iteration.
+ * @param limits Clock of a timed search, or nullptr to search to maxDepth.
+ * @return Deepest completed result with the node count of every participating process.
+ */
+SearchResult Uci::searchPosition(int maxDepth, const TimeManager *limits)
+{
+    launchSearch(maxDepth, limits);
+    return collectSearch();
+}
+
+/**
+ * Starts searching the current position without waiting. In cluster mode the root is
+ * broadcast to the workers first. Workers only get the depth, so a search with a node limit
+ * or searchmoves runs in this process alone and stays limited and reproducible.
+ */
+void Uci::launchSearch(int maxDepth, const TimeManager *limits, uint64_t nodeLimit, const std::vector<Move> &searchMoves)
+{
+    clusterSearch = cluster.isRunning() && nodeLimit == 0 && searchMoves.empty();
+    if (clusterSearch)
+    {
+        cluster.broadcastSearch(board->getFen(), board->gameFensHistory, maxDepth);
+    }
+
+    pool->startSearch(*board, maxDepth, limits, nodeLimit, searchMoves);
+}
+
+/**
+ * Waits for the search started by launchSearch. In cluster mode the workers' results are
+ * merged with ours once our own search completes.
+ */
+SearchResult Uci::collectSearch()
+{
+    SearchResult result = pool->waitForResult();
+
+    if (clusterSearch)
+    {
+        result = cluster.collectResults(result, 2000);
+    }
+    return result;
+}
+
+/**
+ * Handles the "bench" command by searching a fixed set of positions to a fixed depth
+ * (default 5) with a cleared hash table and history, then reporting total nodes, time and
+ * speed. With one thread the node count is a reproducible signature of the search.
+ * The current position is restored afterwards.
+ *
+ * @param parameters Optional search depth.
+ */
+void Uci::handleBench(const std::string &parameters)
+{
+    static const std::vector<std::string> positions = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r2q1rk1/2p1bppp/p1n1bn2/1p2p3/4P3/2P2N2/PPBN1PPP/R1BQR1K1 b - - 1 12",
+        "3r2k1/2p2bpp/p2r4/P2PpP2/BR1q4/7P/5PP1/2R1Q1K1 b - - 2 35",
+        "2rqr1k1/4bpp1/p2p1n1p/1p6/3QP3/1b4NP/PP3PP1/R1B1R1K1 b - - 0 20",
+        "r2q1rk1/1b3ppp/p5n1/1p1pPN2/4n3/4b2P/PPB2PP1/R2QRNK1 w - - 0 19",
+        "3r1bk1/5pp1/7p/p3nP2/8/1B1pB2P/P4PP1/3R2K1 w - - 0 32",
+        "6k1/4bppp/8/2P1P3/1p3B2/1B1b3P/5PP1/6K1 b - - 0 35",
+    };
+
+    int benchDepth = 5;
+    std::istringstream iss(parameters);
+    iss >> benchDepth;
+
+    std::string savedFen = board->getFen();
+    auto savedHistory = board->gameFensHistory;
+
+    uint64_t totalNodes = 0;
+    uint64_t totalQuiescenceNodes = 0;
+    double totalBranchingFactor = 0.0;
+    uint64_t totalCutoffs = 0;
+    uint64_t totalFirstMoveCutoffs = 0;
+    uint64_t totalPawnTableProbes = 0;
+    uint64_t totalPawnTableHits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        board->transpositionTable->clear();
+        pool->newGame();
+        board->setFen(positions[i]);
+        board->gameFensHistory.clear();
+
+        SearchResult result = searchPosition(benchDepth);
+        totalNodes += result.nodes;
+        totalQuiescenceNodes += result.quiescenceNodes;
+        totalBranchingFactor += result.branchingFactor;
+        totalCutoffs += result.betaCutoffs;
+        totalFirstMoveCutoffs += result.firstMoveCutoffs;
+        totalPawnTableProbes += result.pawnTableProbes;
+        totalPawnTableHits += result.pawnTableHits;
+
+        std::cout << "Position " << (i + 1) << "/" << positions.size() << ": bestmove "
+                  << board->moveToString(result.move.from, result.move.to)
+                  << " depth " << result.depth << " nodes " << result.nodes << std::endl;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << "===========================" << std::endl;
+    std::cout << "Total time (ms) : " << elapsedMs << std::endl;
+    std::cout << "Nodes searched  : " << totalNodes << std::endl;
+    std::cout << "Nodes/second    : " << (totalNodes * 1000 / std::max<long long>(elapsedMs, 1)) << std::endl;
+    std::cout << "Quiescence nodes: " << totalQuiescenceNodes << " ("
+              << (totalQuiescenceNodes * 100 / std::max<uint64_t>(totalNodes, 1)) << "%)" << std::endl;
+    std::cout << "Branching factor: " << totalBranchingFactor / positions.size() << std::endl;
+    std::cout << "First-move cuts : " << (totalFirstMoveCutoffs * 100 / std::max<uint64_t>(totalCutoffs, 1)) << "% of "
+              << totalCutoffs << std::endl;
+    std::cout << "Pawn table hits : " << (totalPawnTableHits * 100 / std::max<uint64_t>(totalPawnTableProbes, 1)) << "% of "
+              << totalPawnTableProbes << std::endl;
+    if (cluster.isRunning())
+    {
+        std::cout << "Cluster workers : " << cluster.workerCount() << std::endl;
+    }
+
+    board->setFen(savedFen);
+    board->gameFensHistory = savedHistory;
+}
+
+/**
+ * Handles the "tactics [maxDepth]" command: nodes to solution on the opening positions of the
+ * Win At Chess suite. Each position is searched from scratch to every depth up to maxDepth
+ * (default 10). It is solved at the first depth from which the key move stays the best move,
+ * so a capture that is only played because the search is too shallow to see the recapture
+ * does not count; the nodes of that search are its nodes to solution. Unsolved positions are
+ * left out of the node total.
+ *
+ * @param parameters Optional maximum depth.
+ */
+void Uci::handleTactics(const std::string &parameters)
+{
+    // Win At Chess positions with their key move in coordinate notation
+    static const std::vector<std::pair<std::string, std::string>> positions = {
+        {"2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1", "g3g6"},
+        {"8/7p/5k2/5p2/p1p2P2/Pr1pPK2/1P1R3P/8 b - - 0 1", "b3b2"},
+        {"5rk1/1ppb3p/p1pb4/6q1/3P1p1r/2P1R2P/PP1BQ1P1/5RKN w - - 0 1", "e3g3"},
+        {"r1bq2rk/pp3pbp/2p1p1pQ/7P/3P4/2PB1N2/PP3PPR/2KR4 w - - 0 1", "h6h7"},
+        {"5k2/6pp/p1qN4/1p1p4/3P4/2PKP2Q/PP3r2/3R4 b - - 0 1", "c6c4"},
+        {"7k/p7/1R5K/6r1/6p1/6P1/8/8 w - - 0 1", "b6b7"},
+        {"rnbqkb1r/pppp1ppp/8/4P3/6n1/7P/PPPNPPP1/R1BQKBNR b KQkq - 0 1", "g4e3"},
+        {"r4q1k/p2bR1rp/2p2Q1N/5p2/5p2/2P5/PP3PPP/R5K1 w - - 0 1", "e7f7"},
+        {"3q1rk1/p4pp1/2pb3p/3p4/6Pr/1PNQ4/P1PB1PP1/4RRK1 b - - 0 1", "d6h2"},
+        {"2br2k1/2q3rn/p2NppQ1/2p1P3/Pp5R/4P3/1P3PPP/3R2K1 w - - 0 1", "h4h7"},
+        {"r1b1kb1r/3q1ppp/pBp1pn2/8/Np3P2/5B2/PPP3PP/R2Q1RK1 w kq - 0 1", "f3c6"},
+        {"4k1r1/2p3r1/1pR1p3/3pP2p/3P2qP/P4N2/1PQ4P/5R1K b - - 0 1", "g4f3"},
+        {"5rk1/pp4p1/2n1p2p/2Npq3/2p5/6P1/P3P1BP/R4Q1K w - - 0 1", "f1f8"},
+        {"r2rb1k1/pp1q1p1p/2n1p1p1/2bp4/5P2/PP1BPR1Q/1BPN2PP/R5K1 w - - 0 1", "h3h7"},
+        {"1R6/1brk2p1/4p2p/p1P1Pp2/P7/6P1/1P4P1/2R3K1 w - - 0 1", "b8b7"},
+        {"r4rk1/ppp2ppp/2n5/2bqp3/8/P2PB3/1PP1NPPP/R2Q1RK1 w - - 0 1", "e2c3"},
+        {"R7/P4k2/8/8/8/8/r7/6K1 w - - 0 1", "a8h8"},
+        {"r1b2rk1/ppbn1ppp/4p3/1QP4q/3P4/N4N2/5PPP/R1B2RK1 w - - 0 1", "c5c6"},
+        {"r2qkb1r/1ppb1ppp/p7/4p3/P1Q1P3/2P5/5PPP/R1B2KNR b kq - 0 1", "d7b5"},
+    };
+
+    int maxDepth = 10;
+    std::istringstream iss(parameters);
+    iss >> maxDepth;
+    maxDepth = std::max(maxDepth, 1);
+
+    std::string savedFen = board->getFen();
+    auto savedHistory = board->gameFensHistory;
+
+    int solved = 0;
+    uint64_t totalNodes = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        const auto &[fen, keyMove] = positions[i];
+        board->setFen(fen);
+        board->gameFensHistory.clear();
+
+        auto [keyFrom, keyTo] = board->parseMove(keyMove);
+        Move legalMoves[256];
+        int legalMoveCount = board->getAllLegalMovesAsArray(legalMoves, board->whiteToMove).from;
+        if (std::find(legalMoves, legalMoves + legalMoveCount, Move{keyFrom, keyTo}) == legalMoves + legalMoveCount)
+        {
+            std::cerr << "Error: Key move " << keyMove << " is not legal in " << fen << std::endl;
+            continue;
+        }
+
+        // Nodes of the search to each depth, 0 where its best move is not the key move
+        std::vector<uint64_t> keyNodes(maxDepth + 1, 0);
+        Move bestMove = {-1, -1};
+        for (int depth = 1; depth <= maxDepth; depth++)
+        {
+            board->transpositionTable->clear();
+            pool->newGame();
+            board->setFen(fen);
+            SearchResult result = searchPosition(depth);
+            bestMove = result.move;
+            if (result.move.from == keyFrom && result.move.to == keyTo)
+            {
+                keyNodes[depth] = std::max<uint64_t>(result.nodes, 1);
+            }
+        }
+
+        // Solved from the first depth after which the key move stays the best move
+        int solvedDepth = maxDepth + 1;
+        while (solvedDepth > 1 && keyNodes[solvedDepth - 1] > 0)
+        {
+            solvedDepth--;
+        }
+
+        std::cout << "Position " << (i + 1) << "/" << positions.size() << ": key " << keyMove;
+        if (solvedDepth <= maxDepth)
+        {
+            solved++;
+            totalNodes += keyNodes[solvedDepth];
+            std::cout << " found at depth " << solvedDepth << " nodes " << keyNodes[solvedDepth] << std::endl;
+        }
+        else
+        {
+            std::cout << " not found, bestmove " << board->moveToString(bestMove.from, bestMove.to) << std::endl;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << "===========================" << std::endl;
+    std::cout << "Solved          : " << solved << "/" << positions.size() << std::endl;
+    std::cout << "Nodes to solve  : " << totalNodes << std::endl;
+    std::cout << "Total time (ms) : " << elapsedMs << std::endl;
+
+    board->setFen(savedFen);
+    board->gameFensHistory = savedHistory;
 }
 
 /**
@@ -219,11 +799,47 @@ void Uci::applyBestMove(const Move &bestmove)
 }
 
 /**
- * Handles the "stop" command, halting the search process.
+ * Handles the "stop" command: the running search ends with the deepest completed iteration
+ * and its best move is printed before this returns. Does nothing when no search runs.
  */
 void Uci::handleStop()
 {
-    std::cout << "Engine stopped " << board->getFen() << std::endl;
+    releaseBestMove();
+    pool->stop();
+    waitForSearch();
+}
+
+/**
+ * Handles the "ponderhit" command: the opponent played the move we pondered on, so the
+ * ponder search goes on as a normal timed search with the clock started now.
+ */
+void Uci::handlePonderhit()
+{
+    timeManager.ponderhit();
+    releaseBestMove();
+}
+
+/**
+ * Lets the thread reporting the last "go" print its best move once the search is over.
+ */
+void Uci::releaseBestMove()
+{
+    {
+        std::lock_guard<std::mutex> lock(bestMoveMutex);
+        holdBestMove = false;
+    }
+    bestMoveReleased.notify_all();
+}
+
+/**
+ * Blocks until the thread reporting the last "go" has printed its best move.
+ */
+void Uci::waitForSearch()
+{
+    if (searchThread.joinable())
+    {
+        searchThread.join();
+    }
 }
 
 /**
@@ -231,6 +847,10 @@ void Uci::handleStop()
  */
 void Uci::handleQuit()
 {
+    handleStop();
     std::cout << "Engine quitting" << std::endl;
+    cluster.shutdown();
+    pool.reset();
+    board.reset(); // Unlinks the shared hash segment in cluster mode
     exit(0);
 }
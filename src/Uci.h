@@ -4,12 +4,22 @@
 #include <string>
 #include "Board.h"
 #include "Node.h"
+#include "Cluster.h"
+#include "SearchPool.h"
+#include "SearchParameters.h"
+#include "TimeManager.h"
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 
 class Uci {
 public:
+    // Stops a running search
+    ~Uci();
+
     // Initialize UCI
     void init();
 
@@ -35,11 +45,45 @@ private:
     // Handle the "go" command
     void handleGo(const std::string& parameters);
 
+    // Report and play the best move of the search started by "go"; runs on searchThread
+    void finishGo();
+
     // Handle the "stop" command
     void handleStop();
 
+    // Handle the "ponderhit" command
+    void handlePonderhit();
+
+    // Allow the reporting thread to print the best move of a ponder or infinite search
+    void releaseBestMove();
+
+    // PV or hash move after our best move, suggested to the GUI as the move to ponder on
+    Move expectedReply(Move pvReply);
+
     // Handle the "quit" command
     void handleQuit();
+
+    // Handle the "bench" command: fixed depth search over a set of positions
+    void handleBench(const std::string& parameters);
+
+    // Handle the "tactics" command: nodes to solution on a tactical test suite
+    void handleTactics(const std::string& parameters);
+
+    // Handle the "stats" command: print the statistics of the last search
+    void handleStats();
+
+    // Handle the "latency" command: go-to-output latency on a trivial position against a budget
+    void handleLatency(const std::string& parameters);
+
+    // Search the current position, together with the cluster workers if any
+    SearchResult searchPosition(int maxDepth, const TimeManager *limits = nullptr);
+
+    // The two halves of searchPosition: start the search, then wait for its result
+    void launchSearch(int maxDepth, const TimeManager *limits, uint64_t nodeLimit = 0, const std::vector<Move> &searchMoves = {});
+    SearchResult collectSearch();
+
+    // Wait until the best move of the last "go" has been printed
+    void waitForSearch();
     
     //Apply the move on the internal board
     void applyBestMove(const Move& bestmove);
@@ -53,6 +97,29 @@ private:
     //Initial depth set to 3
     int depth = 3;
 
+    //Milliseconds kept back on every move for GUI and transport latency
+    int moveOverhead = 30;
+
+    //Clock of the current "go"
+    TimeManager timeManager;
+
+    //Waits for the running "go" search and prints its best move
+    std::thread searchThread;
+
+    //Set while a ponder or infinite search must not report its best move yet
+    std::mutex bestMoveMutex;
+    std::condition_variable bestMoveReleased;
+    bool holdBestMove = false;
+
+    //Leader side of the multi-process search, idle unless the Cluster option is set
+    ClusterLeader cluster;
+
+    //Set by launchSearch when the workers were given the search and their results must be collected
+    bool clusterSearch = false;
+
+    //Search threads, created once in init() and woken by every "go"
+    std::unique_ptr<SearchPool> pool;
+
 
 };
 
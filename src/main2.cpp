@@ -2,8 +2,14 @@
 #include "ChessBoardWidget.h"
 #include "Uci.h"
 #include "ChessGameManager.h"
+#include "Cluster.h"
 
 int main(int argc, char *argv[]) {
+    // Helper process of a multi-process search: chessEngine --cluster-worker <socket>
+    if (argc >= 3 && std::string(argv[1]) == "--cluster-worker") {
+        return runClusterWorker(argv[2]);
+    }
+
     QApplication app(argc, argv);
 
     auto board = std::make_shared<Board>(); 